@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file BackgroundModel.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A rolling per-pixel background model for subtracting from frames
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_BACKGROUNDMODEL_HPP
+#define LANE_BACKGROUNDMODEL_HPP
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include "Frame.hpp"
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Keeps an exponentially weighted moving average of the count (TOT)
+/// of every pixel over the frames of each channel, with pixels not hit in a
+/// frame counting as zero. Pixels which are noisy or have a raised pedestal
+/// for a long stretch of frames build up a background, which is taken off
+/// their count in later frames, so that they stop being found as clusters.
+/// Occasional real hits leave too little background behind to matter.
+/// Frames must be given in time order, one channel at a time or interleaved.
+class BackgroundModel final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param weight The weight of each new frame in the moving average,
+    /// between 0 and 1. Roughly the reciprocal of the number of frames
+    /// the background is averaged over.
+    /// \param minLevel Backgrounds below this count aren't subtracted
+    BackgroundModel(const double weight = 0.05, const double minLevel = 1.0);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~BackgroundModel() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    BackgroundModel(const BackgroundModel& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    BackgroundModel(BackgroundModel&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    BackgroundModel& operator=(const BackgroundModel& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    BackgroundModel& operator=(BackgroundModel&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Subtracts the current background of its channel from a frame,
+    /// then adds the frame to the background. Pixels left with a count of
+    /// zero or less are dropped, as are any off the detector (X or Y above
+    /// 255).
+    /// \param frame The frame to subtract the background from
+    /// \param subtracted Set to the frame with the background subtracted
+    /// \return The number of pixels dropped
+    std::size_t subtract(const Frame& frame, Frame& subtracted);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Forgets the background of every channel, for example when
+    /// moving on to a capture which doesn't follow on from the last one
+    void clear() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the current background of a pixel
+    /// \param channelID The ID of the channel
+    /// \param x The x value of the pixel
+    /// \param y The y value of the pixel
+    /// \return The background count, or 0 for an unseen channel
+    double getBackground(
+        const std::uint32_t channelID,
+        const std::uint32_t x,
+        const std::uint32_t y
+    ) const noexcept;
+
+private:
+    double weight_;
+    double minLevel_;
+    // Dense per-channel backgrounds, indexed by pixel key
+    std::map<std::uint32_t, std::vector<float>> channels_;
+};
+
+} // lane
+
+#endif // LANE_BACKGROUNDMODEL_HPP
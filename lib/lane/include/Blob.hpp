@@ -16,8 +16,11 @@
 
 #include <ostream>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 #include "Pixel.hpp"
+#include "Utils/Arena.hpp"
+#include "Utils/SmallVector.hpp"
 
 namespace lane {
 
@@ -25,10 +28,38 @@ namespace lane {
 /// \brief Class for storing pixel blobs
 class Blob final {
 public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The number of pixels a blob holds without allocating. Most
+    /// blobs are this size or smaller.
+    static const std::size_t inlinePixels = 4;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The container type used to store the pixel keys
+    typedef utils::SmallVector<
+        std::uint32_t,
+        inlinePixels,
+        utils::ArenaAllocator<std::uint32_t>
+    > KeyList;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The container type used to store the pixel data. Pixels are
+    /// stored packed and contiguously, in the same order as their keys.
+    typedef utils::SmallVector<
+        Pixel,
+        inlinePixels,
+        utils::ArenaAllocator<Pixel>
+    > PixelList;
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Constructor
     Blob();
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. The blob draws its storage from the given arena,
+    /// so it must not outlive the arena's next reset.
+    /// \param arena The arena to allocate storage from
+    explicit Blob(utils::Arena& arena);
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Destructor
     ~Blob() noexcept;
@@ -68,46 +99,65 @@ public:
     /// the blob.
     /// \return A beginning iterator to the list of pixel keys associated with the
     /// blob.
-    std::vector<std::uint32_t>::iterator begin() noexcept;
+    KeyList::iterator begin() noexcept;
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Gets an iterator pointing to the last pixel key associated with
     /// the blob.
     /// \return An ending iterator to the list of pixel keys associated with the
     /// blob.
-    std::vector<std::uint32_t>::iterator end() noexcept;
+    KeyList::iterator end() noexcept;
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Gets a const iterator pointing to the first pixel key associated
     /// with the blob.
     /// \return A const beginning iterator to the list of pixel keys associated
     /// with the blob.
-    std::vector<std::uint32_t>::const_iterator begin() const noexcept;
+    KeyList::const_iterator begin() const noexcept;
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Gets a const iterator pointing to the first pixel key associated
     /// with the blob.
     /// \return A const beginning iterator to the list of pixel keys associated
     /// withe the blob.
-    std::vector<std::uint32_t>::const_iterator end() const noexcept;
+    KeyList::const_iterator end() const noexcept;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief Adds the key value of the pixel to the blob
+    /// \brief Gets the pixels in the blob, including their count and energy
+    /// values, so that they don't have to be looked up in the frame again.
+    /// \return A constant reference to the pixels in the blob
+    const PixelList& getPixels() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the pixels in the blob, including their count and energy
+    /// values. Allows, for example, the energies to be filled in place.
+    /// \return A reference to the pixels in the blob
+    PixelList& getPixels() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of pixels in the blob
+    /// \return The number of pixels in the blob
+    std::size_t getSize() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds the pixel and its key value to the blob
     /// \param pixel The pixel to add to the blob.
     void addPixel(const Pixel& pixel) noexcept;
 
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief Adds the key value of the pixel to the blob
+    /// \brief Adds the key value of the pixel to the blob. The stored pixel
+    /// data only has its coordinates set, as the count isn't known.
     /// \param key The pixel key to add to the blob.
     void addPixelKey(const std::uint32_t key) noexcept;
     
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief Adds the key value of the pixel to the blob
+    /// \brief Adds the pixels and their key values to the blob
     /// \param pixels The pixels to add to the blob.
     void addPixels(const std::vector<Pixel>& pixels) noexcept;
     
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief Adds the key value of the pixel to the blob
+    /// \brief Adds the key values of the pixels to the blob. The stored pixel
+    /// data only has its coordinates set, as the counts aren't known.
     /// \param keys The pixel keys to add to the blob.
     void addPixelKeys(const std::vector<std::uint32_t>& keys) noexcept;
 
@@ -119,9 +169,15 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const Blob& blob) noexcept;
 
 private:
-    std::vector<std::uint32_t> pixelKeys_;
+    KeyList pixelKeys_;
+    PixelList pixels_;
 };
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A list of blobs drawing its storage from an arena (or the heap if no
+/// arena is given)
+typedef std::vector<Blob, utils::ArenaAllocator<Blob>> BlobList;
+
 } // lane
 
 #endif // LANE_BLOB_HPP
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include "Frame.hpp"
 #include "Blob.hpp"
+#include "Utils/Arena.hpp"
 
 namespace lane {
 
@@ -33,6 +34,22 @@ std::vector<Blob> findBlobs(
     const unsigned int threshold = 1
 ) noexcept;
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Analyses a given frame to find blobs of pixels.
+/// Uses a simple neighbouring algorithm to group pixels. All the storage for
+/// the result and for any temporaries is drawn from the given arena, so the
+/// result must be destroyed before the arena is next reset.
+/// \param frame The frame to analyse for blobs
+/// \param arena The arena to allocate from (typically reset once per frame)
+/// \param threshold The count value above which to consider for blobbing.
+/// Useful for filtering out noise from blobbing. Defaults to 1.
+/// \return A list of found blobs
+BlobList findBlobs(
+    const Frame& frame,
+    utils::Arena& arena,
+    const unsigned int threshold = 1
+) noexcept;
+
 } // lane
 
 #endif // LANE_BLOBFINDER_HPP
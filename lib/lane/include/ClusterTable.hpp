@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ClusterTable.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Block based columnar storage for cluster analysis results, and
+/// queries over it
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_CLUSTERTABLE_HPP
+#define LANE_CLUSTERTABLE_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes rows of named numeric columns (typically one row per
+/// cluster) to a LANE cluster table (.lct) file.
+/// Rows are stored in blocks. Each block keeps its columns contiguously and
+/// starts with the minimum and maximum of every column, so that readers can
+/// skip whole blocks which can't match a query, and read only the columns
+/// they need from the rest.
+class ClusterTableWriter final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Creates the table file and writes its header.
+    /// \param fileName The name/path of the file to write to
+    /// \param columns The names of the columns
+    /// \param blockSize The number of rows per block
+    ClusterTableWriter(
+        const std::string& fileName,
+        const std::vector<std::string>& columns,
+        const std::size_t blockSize = 4096
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor. Writes out any buffered rows.
+    ~ClusterTableWriter() noexcept;
+
+    ClusterTableWriter(const ClusterTableWriter& other) = delete;
+
+    ClusterTableWriter(ClusterTableWriter&& other) = delete;
+
+    ClusterTableWriter& operator=(const ClusterTableWriter& other) = delete;
+
+    ClusterTableWriter& operator=(ClusterTableWriter&& other) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a row to the table
+    /// \param values The values of the row, one per column in column order
+    void addRow(const double* values);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a row to the table
+    /// \param values The values of the row, one per column in column order
+    void addRow(const std::vector<double>& values);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Writes out any buffered rows and closes the file
+    void close();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the names of the columns
+    /// \return The names of the columns
+    const std::vector<std::string>& getColumns() const noexcept;
+
+private:
+    void writeBlock();
+
+    std::ofstream output_;
+    std::string fileName_;
+    std::vector<std::string> columns_;
+    std::size_t blockSize_;
+    // Buffered block, stored column after column
+    std::vector<double> block_;
+    std::size_t rows_;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A condition that a column's value lies within [min, max]
+struct RangePredicate {
+    std::string column;
+    double min;
+    double max;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The result of running a ClusterQuery
+struct QueryResult {
+    /// The names of the selected columns
+    std::vector<std::string> columns;
+    /// The values of the matching rows, one vector per selected column
+    std::vector<std::vector<double>> values;
+    /// The number of blocks looked at
+    std::uint64_t blocksScanned = 0;
+    /// The number of blocks skipped using their minimum/maximum statistics
+    std::uint64_t blocksSkipped = 0;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of matching rows
+    /// \return The number of matching rows
+    std::size_t getRowCount() const noexcept;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A query over LANE cluster table files, supporting column
+/// projection and range predicates on any column. Predicates are pushed
+/// down to the block statistics, so blocks which can't match are skipped
+/// without reading their data, and only the needed columns are read from
+/// the rest.
+class ClusterQuery final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Creates a query selecting every column of every
+    /// row.
+    ClusterQuery();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~ClusterQuery() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    ClusterQuery(const ClusterQuery& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    ClusterQuery(ClusterQuery&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    ClusterQuery& operator=(const ClusterQuery& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    ClusterQuery& operator=(ClusterQuery&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Sets the columns to output. An empty list selects them all.
+    /// \param columns The names of the columns to output
+    /// \return A reference to this query
+    ClusterQuery& select(const std::vector<std::string>& columns);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a condition that a column's value lies within [min, max].
+    /// Rows must match every condition.
+    /// \param column The name of the column
+    /// \param min The minimum allowed value
+    /// \param max The maximum allowed value
+    /// \return A reference to this query
+    ClusterQuery& where(
+        const std::string& column,
+        const double min,
+        const double max
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Runs the query over a table file, appending the matching rows
+    /// to the result
+    /// \param fileName The name/path of the table file
+    /// \param result The result to append to
+    void run(const std::string& fileName, QueryResult& result) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Runs the query over a table file
+    /// \param fileName The name/path of the table file
+    /// \return The matching rows
+    QueryResult run(const std::string& fileName) const;
+
+private:
+    std::vector<std::string> columns_;
+    std::vector<RangePredicate> predicates_;
+};
+
+} // lane
+
+#endif // LANE_CLUSTERTABLE_HPP
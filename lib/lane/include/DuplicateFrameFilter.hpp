@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file DuplicateFrameFilter.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Spotting frames repeated in a stream of frames
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_DUPLICATEFRAMEFILTER_HPP
+#define LANE_DUPLICATEFRAMEFILTER_HPP
+
+#include <vector>
+#include <unordered_set>
+#include <cstddef>
+#include <cstdint>
+#include "Frame.hpp"
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Spots frames which have already been seen in a stream of frames,
+/// such as those retransmitted in downlinked data or in overlapping
+/// fragments of a capture, in a single pass. Frames are compared by their
+/// fingerprints (see Frame::getFingerprint), and only the fingerprints of
+/// a fixed number of the most recent frames are kept, so the memory used is
+/// bounded. Repeats turn up close to the frames they repeat, but one coming
+/// after more than that number of other frames isn't spotted.
+class DuplicateFrameFilter final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The number of fingerprints kept by default, a few megabytes
+    /// worth
+    static const std::size_t defaultCapacity = 65536;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param capacity The number of most recent fingerprints to keep
+    /// (at least 1)
+    explicit DuplicateFrameFilter(const std::size_t capacity = defaultCapacity);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~DuplicateFrameFilter() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    DuplicateFrameFilter(const DuplicateFrameFilter& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    DuplicateFrameFilter(DuplicateFrameFilter&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    DuplicateFrameFilter& operator=(const DuplicateFrameFilter& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    DuplicateFrameFilter& operator=(DuplicateFrameFilter&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether a frame repeats one seen recently, remembering
+    /// it if not
+    /// \param frame The next frame of the stream
+    /// \return Whether the frame is a repeat, and should be dropped
+    bool isDuplicate(const Frame& frame);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether a fingerprint has been seen recently,
+    /// remembering it if not
+    /// \param fingerprint The fingerprint of the next frame of the stream
+    /// \return Whether the fingerprint is a repeat
+    bool isDuplicate(const std::uint64_t fingerprint);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Forgets the frames seen so far, to start on another stream.
+    /// The count of repeats is kept.
+    void clear() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of repeats found
+    /// \return The number of repeated frames
+    std::uint64_t getDuplicateCount() const noexcept;
+
+private:
+    std::size_t capacity_;
+    std::unordered_set<std::uint64_t> seen_;
+    // The fingerprints in seen_, oldest first from position_ once full
+    std::vector<std::uint64_t> recent_;
+    std::size_t position_;
+    std::uint64_t duplicateCount_;
+};
+
+} // lane
+
+#endif // LANE_DUPLICATEFRAMEFILTER_HPP
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file EventBuilder.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Joins the frames of several channels into multi-chip events
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_EVENTBUILDER_HPP
+#define LANE_EVENTBUILDER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "Frame.hpp"
+#include "FrameSource.hpp"
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The frames taken by every chip in a single exposure
+struct Event {
+    /// The time stamp of the exposure
+    std::uint32_t timeStamp;
+    /// The sub second time stamp of the exposure
+    std::uint32_t timeStampSub;
+    /// The frame of each channel which took part, in the order the sources
+    /// were added
+    std::vector<Frame> frames;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Merges per channel streams of frames into events, each made of the
+/// frames sharing a time stamp and sub second time stamp.
+/// Every source must give its frames in time order, which lets the streams
+/// be joined in a single pass, only holding one frame per source at a time.
+class EventBuilder final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    EventBuilder() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~EventBuilder() noexcept;
+
+    EventBuilder(const EventBuilder& other) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    EventBuilder(EventBuilder&& other);
+
+    EventBuilder& operator=(const EventBuilder& other) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    EventBuilder& operator=(EventBuilder&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a stream of frames to join. Sources must be added before
+    /// the first event is taken.
+    /// \param source The source of the frames
+    void addSource(std::unique_ptr<FrameSource> source);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a streaming source for every channel in a LANE file
+    /// \param fileName The name/path of the LANE file
+    void addLaneFile(const std::string& fileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the next event
+    /// \param event The event to store the next event in
+    /// \return False if there are no events left, true otherwise
+    bool next(Event& event);
+
+private:
+    struct Head {
+        std::unique_ptr<FrameSource> source;
+        Frame frame;
+        bool hasFrame;
+    };
+
+    std::vector<Head> heads_;
+    bool isStarted_;
+};
+
+} // lane
+
+#endif // LANE_EVENTBUILDER_HPP
@@ -128,6 +128,16 @@ public:
     /// \return A constant reference to all the pixels
     const std::map<std::uint32_t, Pixel>& getPixels() const noexcept;
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets a 64-bit fingerprint of the frame: a hash of its channel,
+    /// time stamp and pixels (positions and counts). Frames with the same
+    /// channel, time stamps and pixels have the same fingerprint, and
+    /// different frames almost never do, so it stands in for a full
+    /// comparison when looking for repeated frames.
+    /// The energies of the pixels aren't included.
+    /// \return The fingerprint of the frame
+    std::uint64_t getFingerprint() const noexcept;
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Overloaded ostream operator for the Frame class
     /// \param os The output stream
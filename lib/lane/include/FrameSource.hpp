@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file FrameSource.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A frame source parent class and an in memory frame source
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_FRAMESOURCE_HPP
+#define LANE_FRAMESOURCE_HPP
+
+#include <vector>
+#include <cstddef>
+#include "Frame.hpp"
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A pure virtual base class for sources of a stream of frames, such
+/// as the frames of one channel of a file
+class FrameSource {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Virtual destructor
+    virtual ~FrameSource();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The pure virtual member function for getting the next frame
+    /// \param frame The frame to store the next frame in
+    /// \return False if there are no frames left, true otherwise
+    virtual bool next(Frame& frame) = 0;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A source for frames already held in memory
+class FrameListSource final : public FrameSource {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param frames The frames to give out, in order
+    explicit FrameListSource(std::vector<Frame> frames);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~FrameListSource();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the next frame in the list
+    /// \param frame The frame to store the next frame in
+    /// \return False if there are no frames left, true otherwise
+    virtual bool next(Frame& frame);
+
+private:
+    std::vector<Frame> frames_;
+    std::size_t position_;
+};
+
+} // lane
+
+#endif // LANE_FRAMESOURCE_HPP
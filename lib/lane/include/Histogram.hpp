@@ -0,0 +1,211 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Histogram.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Mergeable fixed and logarithmic bin histograms
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_HISTOGRAM_HPP
+#define LANE_HISTOGRAM_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A named one dimensional histogram with equal width bins on either a
+/// linear or logarithmic scale.
+/// Counts are integers, so merging histograms (from different threads or
+/// files) gives exactly the same result whatever order it's done in.
+class Histogram final {
+public:
+    enum class Binning : std::uint32_t {
+        Linear = 0,
+        Logarithmic = 1
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Creates an empty histogram with no bins.
+    Histogram() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param name The name of the histogram
+    /// \param binCount The number of bins
+    /// \param min The lower edge of the first bin
+    /// \param max The upper edge of the last bin
+    /// \param binning Whether bins are of equal width in value, or in the
+    /// logarithm of the value (in which case min must be positive)
+    Histogram(
+        const std::string& name,
+        const std::size_t binCount,
+        const double min,
+        const double max,
+        const Binning binning = Binning::Linear
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~Histogram() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    Histogram(const Histogram& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    Histogram(Histogram&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    Histogram& operator=(const Histogram& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    Histogram& operator=(Histogram&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Counts a value. Values below the range go in the underflow,
+    /// values at or above it in the overflow, and NaN values are ignored.
+    /// \param value The value to count
+    void fill(const double value) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Counts a number of values
+    /// \param values The values to count
+    /// \param count The number of values
+    void fill(const double* values, const std::size_t count) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds the counts of another histogram with the same binning
+    /// \param other The histogram to add
+    void merge(const Histogram& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Sets all the counts back to zero
+    void clear() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the name of the histogram
+    /// \return The name of the histogram
+    const std::string& getName() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the kind of binning used
+    /// \return The kind of binning used
+    Binning getBinning() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of bins
+    /// \return The number of bins
+    std::size_t getBinCount() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the lower edge of the first bin
+    /// \return The lower edge of the first bin
+    double getMin() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the upper edge of the last bin
+    /// \return The upper edge of the last bin
+    double getMax() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the lower edge of a bin
+    /// \param bin The index of the bin (may be getBinCount() for the upper
+    /// edge of the last bin)
+    /// \return The lower edge of the bin
+    double getBinEdge(const std::size_t bin) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the count of a bin
+    /// \param bin The index of the bin
+    /// \return The count of the bin
+    std::uint64_t getCount(const std::size_t bin) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of values below the range
+    /// \return The number of values below the range
+    std::uint64_t getUnderflow() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of values at or above the range
+    /// \return The number of values at or above the range
+    std::uint64_t getOverflow() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of values counted, including the underflow and
+    /// overflow
+    /// \return The number of values counted
+    std::uint64_t getEntries() const noexcept;
+
+private:
+    std::string name_;
+    Binning binning_;
+    double min_;
+    double max_;
+    // Start and bin width on the (possibly logarithmic) scale, and the
+    // inverse of the width
+    double start_;
+    double width_;
+    double scale_;
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t underflow_;
+    std::uint64_t overflow_;
+
+    friend std::vector<Histogram> readHistograms(const std::string& fileName);
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Adds the counts of each histogram in a list to the histogram at the
+/// same position in another list. An empty list takes on a copy of the other.
+/// \param histograms The list of histograms to add to
+/// \param others The list of histograms to add
+void mergeHistograms(
+    std::vector<Histogram>& histograms,
+    const std::vector<Histogram>& others
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads a list of histograms from a binary histogram (.hist) file
+/// \param fileName The name/path of the file to read
+/// \return The histograms in the file
+std::vector<Histogram> readHistograms(const std::string& fileName);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes a list of histograms to a binary histogram (.hist) file
+/// \param fileName The name/path of the file to write
+/// \param histograms The histograms to write
+void writeHistograms(
+    const std::string& fileName,
+    const std::vector<Histogram>& histograms
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes a list of histograms to a CSV file, with a row per bin
+/// giving the histogram's name, the bin's edges and its count. The underflow
+/// and overflow are included as bins extending to -inf and inf.
+/// \param fileName The name/path of the file to write
+/// \param histograms The histograms to write
+void writeHistogramsCsv(
+    const std::string& fileName,
+    const std::vector<Histogram>& histograms
+);
+
+} // lane
+
+#endif // LANE_HISTOGRAM_HPP
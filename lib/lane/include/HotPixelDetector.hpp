@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file HotPixelDetector.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Streaming detection of hot (noisy) pixels
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_HOTPIXELDETECTOR_HPP
+#define LANE_HOTPIXELDETECTOR_HPP
+
+#include <map>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "Frame.hpp"
+#include "PixelMask.hpp"
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The limits beyond which a pixel is considered hot
+struct HotPixelThresholds {
+    /// The minimum number of frames a channel must have before any of its
+    /// pixels are judged
+    std::uint64_t minFrames = 100;
+    /// A pixel hit in more than this fraction of frames is hot
+    double maxHitFraction = 0.01;
+    /// A pixel with a mean count above this is hot (disabled if <= 0)
+    double maxMeanCount = 0.0;
+    /// The minimum number of hits before the count spread is judged
+    std::uint64_t minHitsForSpread = 100;
+    /// A pixel with a count standard deviation at or below this is stuck,
+    /// and so considered hot (disabled if < 0)
+    double minCountStdDev = -1.0;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Accumulates per-pixel hit frequency and count (TOT) statistics over
+/// a stream of frames, and produces masks of the pixels which look noisy.
+/// A detector isn't shared between threads: give each thread its own, which
+/// then needs no locking, and merge them together at the end.
+class HotPixelDetector final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    HotPixelDetector();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~HotPixelDetector() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    HotPixelDetector(const HotPixelDetector& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    HotPixelDetector(HotPixelDetector&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    HotPixelDetector& operator=(const HotPixelDetector& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    HotPixelDetector& operator=(HotPixelDetector&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds the hits of a frame to the statistics of its channel.
+    /// Pixels off the detector (X or Y above 255) are ignored.
+    /// \param frame The frame to add
+    void addFrame(const Frame& frame);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds the statistics gathered by another detector (for example
+    /// one belonging to another thread) to this one
+    /// \param other The detector to merge in
+    void merge(const HotPixelDetector& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Writes the statistics gathered so far to a binary file, storing
+    /// only the pixels which were hit, so they can be merged into another
+    /// detector later on without seeing the frames again
+    /// Throws a std::runtime_error if the file can't be written.
+    /// \param fileName The name/path of the file to write to
+    void write(const std::string& fileName) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Replaces the statistics with those read from a file written by
+    /// write. Throws a std::runtime_error if the file can't be read or isn't
+    /// a valid statistics file.
+    /// \param fileName The name/path of the file to read in
+    void read(const std::string& fileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the IDs of the channels seen so far
+    /// \return A list of channel IDs
+    std::vector<std::uint32_t> getChannelIDs() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of frames seen for a channel
+    /// \param channelID The ID of the channel
+    /// \return The number of frames
+    std::uint64_t getFrameCount(const std::uint32_t channelID) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of frames in which a pixel was hit
+    /// \param channelID The ID of the channel
+    /// \param x The x value of the pixel
+    /// \param y The y value of the pixel
+    /// \return The number of hits
+    std::uint64_t getHitCount(
+        const std::uint32_t channelID,
+        const std::uint32_t x,
+        const std::uint32_t y
+    ) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the mean count (TOT) value of a pixel over its hits
+    /// \param channelID The ID of the channel
+    /// \param x The x value of the pixel
+    /// \param y The y value of the pixel
+    /// \return The mean count, or 0 if never hit
+    double getMeanCount(
+        const std::uint32_t channelID,
+        const std::uint32_t x,
+        const std::uint32_t y
+    ) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the standard deviation of the count (TOT) value of a pixel
+    /// over its hits
+    /// \param channelID The ID of the channel
+    /// \param x The x value of the pixel
+    /// \param y The y value of the pixel
+    /// \return The standard deviation, or 0 if never hit
+    double getCountStdDev(
+        const std::uint32_t channelID,
+        const std::uint32_t x,
+        const std::uint32_t y
+    ) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds a mask of the pixels of a channel which exceed the given
+    /// thresholds
+    /// \param channelID The ID of the channel
+    /// \param thresholds The limits beyond which a pixel is considered hot
+    /// \return The mask of hot pixels
+    PixelMask getHotPixels(
+        const std::uint32_t channelID,
+        const HotPixelThresholds& thresholds = HotPixelThresholds()
+    ) const noexcept;
+
+private:
+    // Dense per-pixel statistics for a channel, indexed by pixel key.
+    // Kept as integer sums so merging gives the same result in any order
+    struct ChannelStatistics {
+        ChannelStatistics();
+
+        std::uint64_t frames;
+        std::vector<std::uint32_t> hits;
+        std::vector<std::uint64_t> countSums;
+        std::vector<std::uint64_t> countSquareSums;
+    };
+
+    std::map<std::uint32_t, ChannelStatistics> channels_;
+};
+
+} // lane
+
+#endif // LANE_HOTPIXELDETECTOR_HPP
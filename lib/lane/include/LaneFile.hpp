@@ -33,9 +33,11 @@ public:
     LaneFile();
     
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief Overloaded ostream operator for the LaneFile class
+    /// \brief Constructor. Reads in a LANE intermediate file
     /// \param fileName The name/path of the file to read in
-    LaneFile(const std::string& fileName);
+    /// \param threadCount The number of the shared pool's threads to parse
+    /// the file with
+    LaneFile(const std::string& fileName, unsigned int threadCount = 1);
     
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Destructor
@@ -72,9 +74,17 @@ public:
     bool operator!=(const LaneFile& other) const noexcept;
     
     ///////////////////////////////////////////////////////////////////////////
-    /// \brief Reads in a LANE intermediate file
+    /// \brief Reads in a LANE intermediate file.
+    /// With more than one thread, large files are split into chunks on frame
+    /// boundaries (found using the file's index if it has an up to date one,
+    /// or by scanning for end of frame markers otherwise), each chunk is
+    /// parsed as a task on the shared thread pool and the results are merged
+    /// back in order. Repeated frames (see DuplicateFrameFilter) are dropped
+    /// as they're merged.
     /// \param fileName The name/path of the file to read in
-    void read(const std::string& fileName);
+    /// \param threadCount The number of the shared pool's threads to parse
+    /// the file with
+    void read(const std::string& fileName, unsigned int threadCount = 1);
     
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Writes out the stored information to a LANE intermediate file
@@ -93,10 +103,15 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Gets the frames associated with a channel
     /// \param channelID The ID of the channel to grab from
-    /// \return A vector of frames
+    /// \return A vector of frames, empty if the channel has none
     std::vector<Frame> getFrames(
         const std::uint32_t channelID
     ) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the IDs of the channels with frames in the file
+    /// \return A sorted list of the channel IDs
+    std::vector<std::uint32_t> getChannelIDs() const;
     
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Sets the file ID
@@ -118,6 +133,11 @@ public:
     /// \return The start time associated to this file
     std::uint32_t getStartTime() const noexcept;
     
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of repeated frames dropped by the last read
+    /// \return The number of frames dropped
+    std::uint64_t getDuplicateFrameCount() const noexcept;
+    
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Overloaded ostream operator for the LaneFile class
     /// \param os The output stream
@@ -134,6 +154,7 @@ private:
     std::map<std::uint32_t, std::vector<Frame>> channels_;
     std::uint32_t startTime_;
     std::string fileID_;
+    std::uint64_t duplicateCount_ = 0;
 };
 
 } // lane
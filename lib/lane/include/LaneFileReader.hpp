@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneFileReader.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Streams the frames of a channel from a LANE intermediate file
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_LANEFILEREADER_HPP
+#define LANE_LANEFILEREADER_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+#include "Frame.hpp"
+#include "FrameSource.hpp"
+#include "LaneIndex.hpp"
+#include "DuplicateFrameFilter.hpp"
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A frame source which reads the frames of a single channel of a
+/// LANE file one at a time, rather than loading the whole file like LaneFile.
+/// The frames are found using the file's index (see LaneIndex). Repeated
+/// frames (see DuplicateFrameFilter) are skipped as the frames are read in
+/// order.
+class LaneFileReader final : public FrameSource {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Loads the file's index, building it if needed.
+    /// \param fileName The name/path of the LANE file
+    /// \param channelID The channel to read the frames of
+    LaneFileReader(const std::string& fileName, const std::uint32_t channelID);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param fileName The name/path of the LANE file
+    /// \param index An up to date index of the file
+    /// \param channelID The channel to read the frames of
+    LaneFileReader(
+        const std::string& fileName,
+        const LaneIndex& index,
+        const std::uint32_t channelID
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~LaneFileReader();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reads the next frame of the channel which isn't a repeat
+    /// \param frame The frame to store the next frame in
+    /// \return False if there are no frames left, true otherwise
+    virtual bool next(Frame& frame);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Goes back to the first frame of the channel, forgetting the
+    /// frames read so far
+    void rewind() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Moves to a frame of the channel, so that it's the next one
+    /// read. The frame is found using the index, without parsing the frames
+    /// before it. Moving past the last frame leaves none to read. Moving
+    /// back forgets the frames read so far, so they aren't taken as repeats.
+    /// \param frame The position of the frame in the channel, from 0
+    void seek(const std::size_t frame) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reads the frame at a position in the channel, whether it's a
+    /// repeat or not, for sampling frames. The frame is found using the
+    /// index, and the one after it is the next read.
+    /// \param position The position of the frame in the channel, from 0
+    /// \param frame The frame to store the frame read in
+    /// \return False if the position is past the last frame, true otherwise
+    bool readAt(const std::size_t position, Frame& frame);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the total number of frames in the channel
+    /// \return The number of frames in the channel
+    std::size_t getFrameCount() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of repeated frames skipped so far
+    /// \return The number of frames skipped
+    std::uint64_t getDuplicateFrameCount() const noexcept;
+
+private:
+    void open();
+
+    // Reads the next frame, repeat or not
+    bool readFrame(Frame& frame);
+
+    std::string fileName_;
+    std::uint32_t channelID_;
+    std::vector<LaneIndexEntry> entries_;
+    std::size_t position_;
+    std::ifstream input_;
+    // Where the stream was left, to avoid needless seeks
+    std::uint64_t offset_;
+    DuplicateFrameFilter duplicates_;
+};
+
+} // lane
+
+#endif // LANE_LANEFILEREADER_HPP
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneFormat.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Parsing of the lines of LANE intermediate files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_LANEFORMAT_HPP
+#define LANE_LANEFORMAT_HPP
+
+#include <cstdint>
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Parses an unsigned integer from a line of a LANE file, which must
+/// be followed by the given character (or the end of the line). Throws a
+/// std::runtime_error if it isn't.
+/// Shared by the LANE file readers (LaneFile and LaneFileReader) and
+/// LaneIndex.
+/// \param s The text to parse, starting with the number
+/// \param value Where to store the number
+/// \param terminator The character which must follow the number, or '\0'
+/// for the end of the line
+/// \return A pointer just past the terminator, or to the end of the line
+const char* parseLaneNumber(
+    const char* s,
+    std::uint32_t& value,
+    const char terminator
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Parses a pixel line of a LANE file (X,Y,C). Throws a
+/// std::runtime_error if the line is malformed, or the pixel isn't on the
+/// detector (X and Y must be below 256), as pixels are stored by key in
+/// tables of 256 * 256 entries.
+/// \param s The line to parse
+/// \param x Where to store the X position of the pixel
+/// \param y Where to store the Y position of the pixel
+/// \param c Where to store the count (TOT) of the pixel
+void parseLanePixel(
+    const char* s,
+    std::uint32_t& x,
+    std::uint32_t& y,
+    std::uint32_t& c
+);
+
+} // lane
+
+#endif // LANE_LANEFORMAT_HPP
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneIndex.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A frame offset index for LANE intermediate files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_LANEINDEX_HPP
+#define LANE_LANEINDEX_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The location of a single frame in a LANE intermediate file
+struct LaneIndexEntry {
+    /// The channel the frame belongs to
+    std::uint32_t channelID;
+    /// The time stamp of the frame
+    std::uint32_t timeStamp;
+    /// The sub second time stamp of the frame
+    std::uint32_t timeStampSub;
+    /// The byte offset of the frame's time stamp line
+    std::uint64_t offset;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Class for handling frame indices of LANE intermediate files.
+/// An index lists where every frame starts, in file order, so that readers
+/// can split a file or jump straight to a frame without parsing everything
+/// before it. Indices are kept as a sidecar file next to the LANE file.
+class LaneIndex final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    LaneIndex() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Creates an index from entries worked out
+    /// elsewhere, for example for a file written out a piece at a time. The
+    /// file must be finished, as the index records its current state.
+    /// \param entries The entries of all the frames in file order
+    /// \param laneFileName The name/path of the indexed LANE file
+    LaneIndex(
+        std::vector<LaneIndexEntry> entries,
+        const std::string& laneFileName
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~LaneIndex() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    LaneIndex(const LaneIndex& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    LaneIndex(LaneIndex&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    LaneIndex& operator=(const LaneIndex& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    LaneIndex& operator=(LaneIndex&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Builds the index by scanning a LANE intermediate file
+    /// \param laneFileName The name/path of the LANE file to index
+    void build(const std::string& laneFileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reads in an index file
+    /// \param fileName The name/path of the index file to read in
+    void read(const std::string& fileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Writes out the index to an index file
+    /// \param fileName The name/path of the index file to write to
+    void write(const std::string& fileName) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether the index still matches a LANE file (the file
+    /// has the same size and modification time as when the index was built,
+    /// and its first and last few kilobytes are unchanged)
+    /// \param laneFileName The name/path of the LANE file
+    /// \return True if the index matches the file
+    bool isValidFor(const std::string& laneFileName) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the entries of all the frames in file order
+    /// \return A constant reference to the index entries
+    const std::vector<LaneIndexEntry>& getEntries() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the entries of the frames of a single channel in file order
+    /// \param channelID The ID of the channel
+    /// \return A list of the channel's index entries
+    std::vector<LaneIndexEntry> getEntries(
+        const std::uint32_t channelID
+    ) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the IDs of the channels with frames in the file
+    /// \return A sorted list of the channel IDs
+    std::vector<std::uint32_t> getChannelIDs() const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the size of the indexed file in bytes
+    /// \return The size of the indexed file
+    std::uint64_t getFileSize() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the file name used for the sidecar index of a LANE file
+    /// \param laneFileName The name/path of the LANE file
+    /// \return The name/path of the index file
+    static std::string getIndexFileName(const std::string& laneFileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Loads the sidecar index of a LANE file, building it (and
+    /// writing it out, if possible) when it's missing or out of date
+    /// \param laneFileName The name/path of the LANE file
+    /// \return The index for the file
+    static LaneIndex load(const std::string& laneFileName);
+
+private:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Records the state of the indexed file, to check against later
+    /// \param laneFileName The name/path of the LANE file
+    void stamp(const std::string& laneFileName);
+
+    std::vector<LaneIndexEntry> entries_;
+    std::uint64_t fileSize_;
+    std::int64_t modificationTime_;
+    std::uint64_t contentHash_;
+};
+
+} // lane
+
+#endif // LANE_LANEINDEX_HPP
@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LucidFile.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Reads LUCID raw data files straight into frames
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_LUCIDFILE_HPP
+#define LANE_LUCIDFILE_HPP
+
+#include <string>
+#include <map>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Frame.hpp"
+#include "RawInputFile.hpp"
+#include "LucidHeader.hpp"
+#include "DuplicateFrameFilter.hpp"
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Where a frame is in LUCID raw data: its time stamp, then the data
+/// of each channel, up to the next frame marker
+struct LucidFrameRecord {
+    /// The position of the frame marker in the data
+    std::uint64_t offset;
+    /// The number of bytes from the frame marker to the next one (or the end
+    /// of the data)
+    std::uint64_t size;
+    /// True if every channel of the frame repeated one seen before, so the
+    /// record can be dropped as a whole
+    bool isDuplicate;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Class for reading LUCID raw data (.ldat) files, decoding them in
+/// memory rather than converting them to LANE intermediate files first.
+/// Files without a header, which carry on a capture, are read from their
+/// first frame marker onwards. Run length encoded and uncompressed data are
+/// supported, XYV compressed data isn't. Repeated frames (see
+/// DuplicateFrameFilter) are dropped as the file is decoded.
+class LucidFile final : public RawInputFile {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    LucidFile();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Reads in a LUCID raw data file
+    /// \param fileName The name/path of the file to read in
+    explicit LucidFile(const std::string& fileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~LucidFile() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    LucidFile(const LucidFile& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    LucidFile(LucidFile&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    LucidFile& operator=(const LucidFile& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    LucidFile& operator=(LucidFile&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reads in a LUCID raw data file, replacing the current frames.
+    /// Throws a std::runtime_error if the file can't be opened, its data is
+    /// XYV compressed, or the frame or channel markers are out of place.
+    /// A frame cut short at the end of the file is kept as far as it goes.
+    /// \param fileName The name/path of the file to read in
+    void read(const std::string& fileName) override;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reads in a LUCID raw data file, as read(fileName) does, but
+    /// dropping the frames the given filter has seen. Sharing a filter
+    /// between the files of a capture drops the frames repeated in
+    /// overlapping files.
+    /// \param fileName The name/path of the file to read in
+    /// \param duplicates The filter to check the frames against
+    void read(const std::string& fileName, DuplicateFrameFilter& duplicates);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes LUCID raw data held in memory, replacing the current
+    /// frames, as read does for a file. Data arriving in pieces, such as the
+    /// files of a capture, can be decoded a piece at a time: unless the data
+    /// is final, a frame running up to its end is left undecoded, to be
+    /// decoded whole once the rest of it has been added.
+    /// Throws a std::runtime_error as read does.
+    /// \param data The data, starting with a header or a frame marker (or
+    /// the end of a frame, which is skipped)
+    /// \param duplicates The filter to check the frames against
+    /// \param isFinal Whether the data runs to the end of the capture
+    /// \return Where the data left undecoded starts: the frame cut short if
+    /// the data isn't final, or any bytes too few to hold a frame
+    std::size_t decode(
+        const std::vector<unsigned char>& data,
+        DuplicateFrameFilter& duplicates,
+        const bool isFinal = true
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the frames associated with a channel
+    /// \param channelID The ID of the channel to grab from
+    /// \return A vector of frames, empty if the channel has none
+    std::vector<Frame> getFrames(
+        const std::uint32_t channelID
+    ) const noexcept override;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the channel to frame map
+    /// \return A map of channel IDs to frames
+    std::map<std::uint32_t, std::vector<Frame>> getChannelToFramesMap(
+    ) const noexcept override;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the start time, which is 0 for files without a header
+    /// \return The start time
+    std::uint32_t getStartTime() const noexcept override;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the file ID, which is "????" for files without a header
+    /// \return The file ID
+    std::string getFileID() const noexcept override;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the header of the file
+    /// \return The header, which isn't valid for files without one
+    const LucidHeader& getHeader() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of repeated frames dropped by the last read
+    /// \return The number of frames dropped
+    std::uint64_t getDuplicateFrameCount() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets where the frames were in the data last read or decoded,
+    /// in order. Any bytes before the first are the header, or the end of a
+    /// frame carried on from the data before.
+    /// \return The frame records
+    const std::vector<LucidFrameRecord>& getFrameRecords() const noexcept;
+
+private:
+    void clear() noexcept;
+
+    std::size_t decode(
+        const std::vector<unsigned char>& data,
+        const std::string& source,
+        DuplicateFrameFilter& duplicates,
+        const bool isFinal
+    );
+
+    LucidHeader header_;
+    std::map<std::uint32_t, std::vector<Frame>> channels_;
+    std::uint64_t duplicateCount_ = 0;
+    std::vector<LucidFrameRecord> records_;
+};
+
+} // lane
+
+#endif // LANE_LUCIDFILE_HPP
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LucidHeader.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Reading of LUCID raw data file headers, and grouping of raw data
+/// files into captures
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_LUCIDHEADER_HPP
+#define LANE_LUCIDHEADER_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Utils/Filesystem.hpp"
+
+namespace lane {
+
+/// The size of a LUCID raw data file header in bytes
+constexpr std::size_t lucidHeaderSize = 16;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The ways the pixel data of a LUCID raw data file can be stored
+enum class LucidCompression : std::uint8_t {
+    None = 0,
+    RLE,
+    XYV
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The 16-byte header which starts the first file of a LUCID capture.
+/// Later files of the same capture carry straight on with frame data.
+struct LucidHeader {
+    /// Whether the file starts with the header magic (0xDC 0xCC). The other
+    /// fields are only filled in if so
+    bool isValid = false;
+    /// Bit field of the active chips (bit N set for chip N)
+    std::uint8_t activeChips = 0;
+    /// The matrix table (10 bits)
+    std::uint16_t matrixTable = 0;
+    /// The shutter mode
+    std::uint16_t shutterMode = 0;
+    /// How the pixel data is stored
+    LucidCompression compression = LucidCompression::None;
+    /// Whether a linear look up table was used, rather than a PRN one
+    bool isLinearLUT = false;
+    /// The shutter rate
+    std::uint8_t shutterRate = 0;
+    /// The start time of the capture as a UNIX time
+    std::uint32_t startTime = 0;
+    /// The 4 character configuration ID of the capture
+    std::string fileID;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Parses a LUCID raw data file header
+/// \param bytes The first lucidHeaderSize bytes of the file
+/// \return The header, which isn't valid if the magic doesn't match
+LucidHeader parseLucidHeader(const unsigned char* bytes);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads the header of a LUCID raw data file, with a single read of
+/// its first 16 bytes
+/// \param fileName The name/path of the file
+/// \return The header, which isn't valid if the file is too short or
+/// doesn't start with one
+LucidHeader readLucidHeader(const std::string& fileName);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A LUCID raw data file along with its header
+struct LucidFileInfo {
+    /// The path and size of the file
+    utils::FileInfo file;
+    /// The header of the file, not valid for files continuing a capture
+    LucidHeader header;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads the headers of many LUCID raw data files, using a number
+/// of the shared pool's threads, each reading just the header of one file at
+/// a time
+/// \param files The files to read the headers of
+/// \param threads The number of threads to use (0 for all of the pool's)
+/// \return The files with their headers, in the order given
+std::vector<LucidFileInfo> scanLucidHeaders(
+    const std::vector<utils::FileInfo>& files,
+    unsigned int threads = 0
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A capture, made up of a file starting with a header and the files
+/// which carry on from it
+struct LucidCapture {
+    /// The header of the capture's first file, not valid if the capture's
+    /// files had no file with a header before them
+    LucidHeader header;
+    /// The files of the capture, in order
+    std::vector<utils::FileInfo> files;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the time stamp part of a LUCID raw data file name, which is
+/// of the form T1_LU_NUMBER_YYYYMMDD_HHMMSS, for putting files in the order
+/// they were written
+/// \param path The path of the file
+/// \return "YYYYMMDD_HHMMSS", or the file name without its extension if it
+/// isn't of that form
+std::string getLucidFileTimeStamp(const std::string& path);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Groups LUCID raw data files into captures. Files are put in the
+/// order they were written, by the time stamps in their names, and each
+/// file with a header starts a new capture which the files after it without
+/// one belong to. The captures are sorted by start time then file ID.
+/// \param files The files with their headers
+/// \return The captures
+std::vector<LucidCapture> groupLucidCaptures(std::vector<LucidFileInfo> files);
+
+} // lane
+
+#endif // LANE_LUCIDHEADER_HPP
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file PixelMask.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Pixel mask storage class
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_PIXELMASK_HPP
+#define LANE_PIXELMASK_HPP
+
+#include <string>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include "Frame.hpp"
+
+namespace lane {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Class for storing which pixels of a detector should be ignored
+class PixelMask final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Creates a mask with no pixels masked.
+    PixelMask() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Reads in a mask file.
+    /// \param fileName The name/path of the file to read in
+    explicit PixelMask(const std::string& fileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~PixelMask() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    PixelMask(const PixelMask& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    PixelMask(PixelMask&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    PixelMask& operator=(const PixelMask& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    PixelMask& operator=(PixelMask&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Equality operator
+    /// \param other Object to be compared against
+    bool operator==(const PixelMask& other) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Inequality operator
+    /// \param other Object to be compared against
+    bool operator!=(const PixelMask& other) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reads in a mask file, replacing the current mask. The format is
+    /// one "X,Y" line per masked pixel, with '#' starting a comment line.
+    /// \param fileName The name/path of the file to read in
+    void read(const std::string& fileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Writes out the mask to a mask file
+    /// \param fileName The name/path of the file to write to
+    void write(const std::string& fileName) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Masks or unmasks a pixel
+    /// \param x The x value of the pixel
+    /// \param y The y value of the pixel
+    /// \param isMasked Whether the pixel should be masked
+    void setMasked(
+        const std::uint32_t x,
+        const std::uint32_t y,
+        const bool isMasked = true
+    ) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether a pixel is masked
+    /// \param x The x value of the pixel
+    /// \param y The y value of the pixel
+    /// \return True if the pixel is masked
+    bool isMasked(
+        const std::uint32_t x,
+        const std::uint32_t y
+    ) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of masked pixels
+    /// \return The number of masked pixels
+    std::size_t getMaskedCount() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Masks every pixel which is masked in the other mask as well
+    /// \param other The mask to combine with this one
+    void merge(const PixelMask& other) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copies a frame, leaving out its masked pixels
+    /// \param frame The frame to mask
+    /// \param masked The frame to write the unmasked pixels to, replacing
+    /// what it held
+    /// \return The number of pixels left out
+    std::size_t apply(const Frame& frame, Frame& masked) const;
+
+private:
+    std::bitset<256 * 256> masked_;
+};
+
+} // lane
+
+#endif // LANE_PIXELMASK_HPP
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file RleDecode.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Decoding of run length encoded LUCID frame data
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_RLEDECODE_HPP
+#define LANE_RLEDECODE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Pixel.hpp"
+#include "Utils/Endian.hpp"
+
+namespace lane {
+
+/// The width of a detector frame in pixels
+constexpr std::uint32_t frameWidth = 256;
+/// The height of a detector frame in pixels
+constexpr std::uint32_t frameHeight = 256;
+/// The number of pixels in a detector frame
+constexpr std::uint32_t framePixelCount = frameWidth * frameHeight;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Decodes one channel's run length encoded pixel data into a dense
+/// image. Pixels are stored in rows of 256 from the bottom left, so pixel
+/// (x, y) is image[y * 256 + x]. Zero runs are filled a whole run at a time,
+/// and stretches of payload words are copied in a single loop.
+/// Data running past the end of the frame is ignored.
+/// \param words The data words, in native byte order
+/// \param types The type of each data word
+/// \param count The number of words
+/// \param image The image to decode into, of framePixelCount entries. Every
+/// entry is written, so it needn't be cleared first.
+/// \return The number of words decoded, which is the index of the first
+/// control word, or count if there isn't one
+std::size_t decodeRleDense(
+    const std::uint16_t* words,
+    const utils::WordType* types,
+    const std::size_t count,
+    std::uint16_t* image
+) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Decodes one channel's run length encoded pixel data into a list
+/// of the pixels with non-zero counts. Zero runs are skipped by moving the
+/// position on rather than stepping through them, so the time taken depends
+/// on the number of words rather than the number of pixels.
+/// Data running past the end of the frame is ignored.
+/// \param words The data words, in native byte order
+/// \param types The type of each data word
+/// \param count The number of words
+/// \param hits The list to add the hit pixels to, in position order
+/// \return The number of words decoded, which is the index of the first
+/// control word, or count if there isn't one
+std::size_t decodeRleSparse(
+    const std::uint16_t* words,
+    const utils::WordType* types,
+    const std::size_t count,
+    std::vector<Pixel>& hits
+);
+
+} // lane
+
+#endif // LANE_RLEDECODE_HPP
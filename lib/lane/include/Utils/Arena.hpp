@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Arena.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A monotonic arena allocator and an STL compatible allocator adaptor
+/// for it
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_UTILS_ARENA_HPP
+#define LANE_UTILS_ARENA_HPP
+
+#include <vector>
+#include <new>
+#include <type_traits>
+#include <cstddef>
+
+namespace lane {
+namespace utils {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A monotonic (bump pointer) memory arena.
+/// Memory is handed out from large blocks and is only ever reclaimed all at
+/// once by calling reset(), which keeps the blocks around for reuse. This makes
+/// it suitable for per-frame temporaries. An arena is not thread safe, so use
+/// one arena per thread.
+class Arena final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param blockSize The size in bytes of each block requested from the
+    /// system heap. Larger requests get a block of their own size.
+    explicit Arena(const std::size_t blockSize = 64 * 1024);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor. Releases all blocks back to the system heap.
+    ~Arena() noexcept;
+
+    Arena(const Arena& other) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    Arena(Arena&& other) noexcept;
+
+    Arena& operator=(const Arena& other) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    Arena& operator=(Arena&& other) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Allocates memory from the arena
+    /// \param size The number of bytes to allocate
+    /// \param alignment The alignment required for the memory (power of two)
+    /// \return A pointer to the allocated memory
+    void* allocate(
+        const std::size_t size,
+        const std::size_t alignment = alignof(std::max_align_t)
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Marks all memory handed out by the arena as free. Any objects
+    /// allocated from the arena must have been destroyed beforehand. The
+    /// blocks are kept for reuse, so a warmed up arena doesn't touch the heap.
+    void reset() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Resets the arena and gives all its blocks back to the system heap
+    void release() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of bytes handed out since the last reset
+    /// \return The number of bytes in use
+    std::size_t getBytesUsed() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the total number of bytes held by the arena
+    /// \return The capacity of the arena in bytes
+    std::size_t getCapacity() const noexcept;
+
+private:
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks_;
+    std::size_t currentBlock_;
+    std::size_t offset_;
+    std::size_t blockSize_;
+    std::size_t bytesUsed_;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief An STL compatible allocator which draws memory from an Arena.
+/// A default constructed allocator (one without an arena) falls back to the
+/// global heap, so containers using it behave like their std counterparts
+/// unless an arena is supplied.
+template <typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param arena The arena to allocate from, or nullptr for the heap
+    ArenaAllocator(Arena* arena = nullptr) noexcept
+    : arena_(arena) {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param arena The arena to allocate from
+    ArenaAllocator(Arena& arena) noexcept
+    : arena_(&arena) {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Rebinding copy constructor
+    /// \param other The allocator to share the arena of
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+    : arena_(other.getArena()) {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Allocates storage for a number of objects
+    /// \param n The number of objects to allocate storage for
+    /// \return A pointer to the storage
+    T* allocate(const std::size_t n) {
+        if (arena_ != nullptr) {
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Deallocates storage. A no-op for arena storage, which is only
+    /// reclaimed by resetting the arena.
+    /// \param p The storage to deallocate
+    void deallocate(T* p, const std::size_t) noexcept {
+        if (arena_ == nullptr) {
+            ::operator delete(p);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the arena in use
+    /// \return The arena in use, or nullptr if using the heap
+    Arena* getArena() const noexcept {
+        return arena_;
+    }
+
+private:
+    Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(
+    const ArenaAllocator<T>& lhs,
+    const ArenaAllocator<U>& rhs
+) noexcept {
+    return lhs.getArena() == rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(
+    const ArenaAllocator<T>& lhs,
+    const ArenaAllocator<U>& rhs
+) noexcept {
+    return !(lhs == rhs);
+}
+
+} // utils
+} // lane
+
+#endif // LANE_UTILS_ARENA_HPP
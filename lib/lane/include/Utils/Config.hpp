@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Config.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A simple INI style configuration file reader
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved. 
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_UTILS_CONFIG_HPP
+#define LANE_UTILS_CONFIG_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace lane {
+namespace utils {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Holds the settings from an INI style configuration file, in the
+/// same format as the lane config.ini:
+/// [section]
+/// key: value
+/// Lines starting with '#' or ';' are comments, and '=' may be used in place
+/// of ':'. Section and key names are case-sensitive.
+class Config final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Creates an empty configuration.
+    Config();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Reads in the given configuration file.
+    /// \param fileName The name/path of the file to read in
+    explicit Config(const std::string& fileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~Config() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    Config(const Config& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    Config(Config&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    Config& operator=(const Config& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    Config& operator=(Config&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reads in a configuration file, adding to (and overriding) any
+    /// settings already held.
+    /// \param fileName The name/path of the file to read in
+    void read(const std::string& fileName);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether a setting is present
+    /// \param section The section the setting is in
+    /// \param key The name of the setting
+    /// \return True if the setting is present
+    bool hasValue(
+        const std::string& section,
+        const std::string& key
+    ) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Sets a setting, overriding any existing value
+    /// \param section The section the setting is in
+    /// \param key The name of the setting
+    /// \param value The value to set
+    void setValue(
+        const std::string& section,
+        const std::string& key,
+        const std::string& value
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets a setting as a string
+    /// \param section The section the setting is in
+    /// \param key The name of the setting
+    /// \param defaultValue The value to return if the setting isn't present
+    /// \return The value of the setting
+    std::string getString(
+        const std::string& section,
+        const std::string& key,
+        const std::string& defaultValue = ""
+    ) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets a setting as a floating point number
+    /// \param section The section the setting is in
+    /// \param key The name of the setting
+    /// \param defaultValue The value to return if the setting isn't present
+    /// \return The value of the setting
+    double getDouble(
+        const std::string& section,
+        const std::string& key,
+        const double defaultValue = 0.0
+    ) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets a setting as an integer
+    /// \param section The section the setting is in
+    /// \param key The name of the setting
+    /// \param defaultValue The value to return if the setting isn't present
+    /// \return The value of the setting
+    long long getInteger(
+        const std::string& section,
+        const std::string& key,
+        const long long defaultValue = 0
+    ) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets a setting as a boolean. Accepts true/false, yes/no, on/off
+    /// and 1/0.
+    /// \param section The section the setting is in
+    /// \param key The name of the setting
+    /// \param defaultValue The value to return if the setting isn't present
+    /// \return The value of the setting
+    bool getBool(
+        const std::string& section,
+        const std::string& key,
+        const bool defaultValue = false
+    ) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets a comma separated setting as a list of strings, with the
+    /// surrounding whitespace of each element removed
+    /// \param section The section the setting is in
+    /// \param key The name of the setting
+    /// \return The elements of the setting, or an empty list if not present
+    std::vector<std::string> getList(
+        const std::string& section,
+        const std::string& key
+    ) const;
+
+private:
+    std::map<std::string, std::map<std::string, std::string>> sections_;
+};
+
+} // utils
+} // lane
+
+#endif // LANE_UTILS_CONFIG_HPP
@@ -14,33 +14,39 @@
 #ifndef LANE_UTILS_ENDIAN_HPP
 #define LANE_UTILS_ENDIAN_HPP
 
+#include <cstddef>
 #include <cstdint>
 
 namespace lane {
 namespace utils {
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Set to 1 on big endian targets and 0 on little endian ones. Worked
+/// out from the compiler's predefined macros; can be defined on the command
+/// line for compilers which don't provide them.
+#ifndef LANE_BIG_ENDIAN
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+#define LANE_BIG_ENDIAN (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#elif defined(_WIN32) || defined(__i386__) || defined(__x86_64__) || \
+    defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM) || defined(_M_ARM64)
+#define LANE_BIG_ENDIAN 0
+#else
+#error "Unable to work out the byte order of the target, define LANE_BIG_ENDIAN"
+#endif
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// \brief Checks if the system is big endian
 /// \return A boolean stating true if the system is big endian
-inline bool isBigEndian() noexcept {
-    union {
-        std::uint16_t i;
-        char c[2];
-    } data = { 0x0102 };
-
-    return data.c[0] == 0x01;
+constexpr bool isBigEndian() noexcept {
+    return LANE_BIG_ENDIAN != 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 /// \brief Checks if the system is little endian
 /// \return A boolean stating true if the system is little endian
-inline bool isLittleEndian() noexcept {
-    union {
-        std::uint16_t i;
-        char c[2];
-    } data = { 0x0102 };
-
-    return data.c[0] == 0x02;
+constexpr bool isLittleEndian() noexcept {
+    return LANE_BIG_ENDIAN == 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -48,7 +54,7 @@ inline bool isLittleEndian() noexcept {
 /// \param value The value to be endian swapped
 /// \return The swapped value
 inline std::uint16_t swapEndian(const std::uint16_t value) noexcept {
-	return (value << 8) | (value >> 8);
+	return static_cast<std::uint16_t>((value << 8) | (value >> 8));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -76,7 +82,9 @@ inline std::uint64_t swapEndian(const std::uint64_t value) noexcept {
 /// \param value The value to be endian swapped
 /// \return The swapped value
 inline std::int16_t swapEndian(const std::int16_t value) noexcept {
-	return (value << 8) | (value >> 8);
+    return static_cast<std::int16_t>(
+        swapEndian(static_cast<std::uint16_t>(value))
+    );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -84,7 +92,9 @@ inline std::int16_t swapEndian(const std::int16_t value) noexcept {
 /// \param value The value to be endian swapped
 /// \return The swapped value
 inline std::int32_t swapEndian(const std::int32_t value) noexcept {
-	return (value << 24) | ((value << 8) & 0x00ff0000) | ((value >> 8) & 0x0000ff00) | (value >> 24);
+    return static_cast<std::int32_t>(
+        swapEndian(static_cast<std::uint32_t>(value))
+    );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -99,6 +109,65 @@ inline std::int64_t swapEndian(const std::int64_t value) noexcept {
     return swapped;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The types of the 16-bit words of LUCID raw data, given by their
+/// top bits
+enum class WordType : std::uint8_t {
+    /// 0- : the number of pixels with no hits which follow
+    ZeroRun = 0,
+    /// 10 : the count of a single pixel
+    Payload = 2,
+    /// 11 : a frame or channel marker
+    Control = 3
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the type of a LUCID raw data word
+/// \param word The word, in native byte order
+/// \return The type of the word
+inline WordType getWordType(const std::uint16_t word) noexcept {
+    return (word & 0x8000) == 0 ? WordType::ZeroRun
+        : static_cast<WordType>(word >> 14);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Swaps the endianness of an array of 16-bit values, in place. Uses
+/// SSE2 or AVX2 where the processor has them.
+/// \param values The values to swap
+/// \param count The number of values
+void swapEndian(std::uint16_t* values, const std::size_t count) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Swaps the endianness of an array of 16-bit values into another
+/// array, which may be the same as the input. Uses SSE2 or AVX2 where the
+/// processor has them.
+/// \param input The values to swap
+/// \param output Where to write the swapped values
+/// \param count The number of values
+void swapEndian(
+    const std::uint16_t* input,
+    std::uint16_t* output,
+    const std::size_t count
+) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads big endian 16-bit words, such as those of LUCID raw data,
+/// into native byte order and works out the type of each, in one pass. The
+/// input doesn't need to be aligned and may be the same as the output, so
+/// that a buffer read straight from a file can be decoded in place. The
+/// byte swap is left out at compile time on big endian targets.
+/// \param input The big endian words
+/// \param words Where to write the words in native byte order
+/// \param types Where to write the type of each word
+/// \param count The number of words
+/// \return The number of control words found
+std::size_t decodeBigEndianWords(
+    const void* input,
+    std::uint16_t* words,
+    WordType* types,
+    const std::size_t count
+) noexcept;
+
 } // utils
 } // lane
 
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file FileWatcher.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Watches a directory tree for new files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_UTILS_FILEWATCHER_HPP
+#define LANE_UTILS_FILEWATCHER_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace lane {
+namespace utils {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Watches a directory and all its sub-directories, including those
+/// made later, for files with a given extension being finished. On Linux
+/// inotify tells of files as soon as they're closed after writing or moved
+/// into the tree. Elsewhere the tree is polled, and a file is taken to be
+/// finished once its size stops changing between looks. Files already there
+/// when the watch starts aren't reported, apart from those in directories
+/// moved in after it starts. Each file is only reported once, even if it's
+/// written to again. On Linux, if events are lost because the kernel's queue
+/// overflowed, the tree is looked through again and the files not yet
+/// reported are polled for like this until they're finished, as are the
+/// files already in a directory when it's made.
+class FileWatcher final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Starts watching a directory tree. Throws a
+    /// std::runtime_error if the directory can't be watched.
+    /// \param directory The directory to watch
+    /// \param extension The extension of the files to report (without the
+    /// dot)
+    FileWatcher(const std::string& directory, const std::string& extension);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor. Stops watching.
+    ~FileWatcher() noexcept;
+
+    FileWatcher(const FileWatcher& other) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    FileWatcher(FileWatcher&& other) noexcept;
+
+    FileWatcher& operator=(const FileWatcher& other) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    FileWatcher& operator=(FileWatcher&& other) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Waits for files to be finished. Throws a std::runtime_error if
+    /// waiting fails.
+    /// \param timeout The longest time to wait in milliseconds
+    /// \return The paths of the files finished since the last call, in the
+    /// order they were finished, or an empty list if none were before the
+    /// time ran out
+    std::vector<std::string> wait(const unsigned int timeout);
+
+private:
+    struct State;
+
+    std::unique_ptr<State> state_;
+};
+
+} // utils
+} // lane
+
+#endif // LANE_UTILS_FILEWATCHER_HPP
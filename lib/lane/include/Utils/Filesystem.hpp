@@ -16,10 +16,22 @@
 
 #include <vector>
 #include <string>
+#include <cstddef>
+#include <cstdint>
 
 namespace lane {
 namespace utils {
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A file found by walkDirectory
+struct FileInfo {
+    /// The path of the file, starting with the directory walked
+    std::string path;
+    /// The size of the file in bytes
+    std::uint64_t size;
+};
+
+
 ///////////////////////////////////////////////////////////////////////////////
 /// \brief Gets a list of file-paths for all files in a given directory.
 /// Returns an empty vector if the directory is empty. Searches
@@ -30,6 +42,27 @@ std::vector<std::string> getDirectoryContents(
     const std::string& directory
 ) noexcept;
 
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Checks whether a file exists and can be opened for reading.
+/// \param path The path of the file to check.
+/// \return True if the file exists and is readable.
+bool fileExists(const std::string& path) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the size of a file in bytes. Returns 0 if the file can't be
+/// opened.
+/// \param path The path of the file.
+/// \return The size of the file in bytes.
+std::uint64_t getFileSize(const std::string& path) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the time a file was last modified. Returns 0 if the file
+/// can't be found.
+/// \param path The path of the file.
+/// \return The modification time, in nanoseconds since an epoch that
+/// depends on the platform, so only compare times from the same system.
+std::int64_t getModificationTime(const std::string& path) noexcept;
+
 ///////////////////////////////////////////////////////////////////////////////
 /// \brief Gets the file name string of a path. Returns an empty string if 
 /// there is no file name.
@@ -83,6 +116,98 @@ std::vector<std::string> getFilesWithExtension(
     const std::vector<std::string>& files
 ) noexcept;
 
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Checks if a file path has the given extension, without copying it
+/// \param path The file path to check
+/// \param extension The extension, without the dot
+/// \return True if the path has the extension, false otherwise
+bool hasExtension(
+    const std::string& path,
+    const std::string& extension
+) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Finds the files in a directory and all its sub-directories,
+/// along with their sizes. Entry types come from the directory listing where
+/// the platform provides them, so only matching files need to be stat'ed.
+/// Symbolic links to files are followed, but not those to directories.
+/// \param directory The directory to search in
+/// \param extension The extension of the files to find (without the dot),
+/// or an empty string for all files
+/// \param isRecursive Whether to search the sub-directories too, rather than
+/// just the directory itself
+/// \return The full paths and sizes of the files found, in no set order
+std::vector<FileInfo> walkDirectory(
+    const std::string& directory,
+    const std::string& extension = "",
+    const bool isRecursive = true
+) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Sorts files so that the largest come first, for scheduling the
+/// longest work first. Files of the same size are sorted by path.
+/// \param files The files to sort
+void sortLargestFirst(std::vector<FileInfo>& files) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads a range of bytes from a file with a single positioned read
+/// (pread on posix systems), without any stream buffering, for when only a
+/// small part of each of many files is needed
+/// \param fileName The file to read from
+/// \param offset The offset of the first byte to read
+/// \param buffer Where to read the bytes into
+/// \param size The number of bytes to read
+/// \return The number of bytes read, which is less than size if the file
+/// is too short, or 0 if it can't be opened
+std::size_t readFileRange(
+    const std::string& fileName,
+    const std::uint64_t offset,
+    void* buffer,
+    const std::size_t size
+) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Appends a range of bytes from one file onto the end of another,
+/// creating it if it doesn't exist. Where the platform allows, the kernel
+/// copies the data (copy_file_range or sendfile on Linux) without it passing
+/// through user space.
+/// Throws a std::runtime_error if either file can't be opened, the source
+/// ends before the range does, or the copy fails.
+/// \param destination The file to append to
+/// \param source The file to copy from
+/// \param offset The offset in the source of the first byte to copy
+/// \param length The number of bytes to copy
+void appendFileRange(
+    const std::string& destination,
+    const std::string& source,
+    const std::uint64_t offset,
+    const std::uint64_t length
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Creates a directory, along with any missing parent directories
+/// \param path The path of the directory
+/// \return True if the directory exists afterwards
+bool makeDirectory(const std::string& path) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Removes an empty directory
+/// \param path The path of the directory
+/// \return True if the directory was removed
+bool removeDirectory(const std::string& path) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Makes destination a hard link to source, replacing any file
+/// already there, so that the data isn't copied. Falls back to copying the
+/// file where hard links can't be made (for example across file systems).
+/// As the two names then share the same data, the destination mustn't be
+/// written to in place afterwards; remove it and write a new file instead.
+/// Throws a std::runtime_error if neither works.
+/// \param source The file to link to
+/// \param destination The path of the link
+void linkFile(const std::string& source, const std::string& destination);
+
 } // utils
 } // lane
 
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Hash.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Fast non-cryptographic 64-bit hashing of data and files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_UTILS_HASH_HPP
+#define LANE_UTILS_HASH_HPP
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace lane {
+namespace utils {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Works out the 64-bit xxHash (XXH64) of data fed in a piece at a
+/// time. The result is the same however the data is split up, and matches
+/// other XXH64 implementations, so hashes can be checked with standard tools.
+/// It's fast enough that hashing a file costs little more than reading it,
+/// but isn't meant to stand up to deliberate collisions.
+class Hash64 final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param seed The seed of the hash
+    explicit Hash64(const std::uint64_t seed = 0) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds data to the hash
+    /// \param data The data to add
+    /// \param size The size of the data in bytes
+    void update(const void* data, const std::size_t size) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds the characters of a string to the hash
+    /// \param text The string to add
+    void update(const std::string& text) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the hash of the data added so far. More data can still be
+    /// added afterwards.
+    /// \return The hash
+    std::uint64_t getDigest() const noexcept;
+
+private:
+    std::uint64_t seed_;
+    std::uint64_t totalSize_;
+    std::uint64_t lanes_[4];
+    unsigned char buffer_[32];
+    std::size_t bufferSize_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Works out the 64-bit xxHash (XXH64) of some data in one go
+/// \param data The data to hash
+/// \param size The size of the data in bytes
+/// \param seed The seed of the hash
+/// \return The hash
+std::uint64_t hash64(
+    const void* data,
+    const std::size_t size,
+    const std::uint64_t seed = 0
+) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Works out the 64-bit xxHash (XXH64) of the contents of a file.
+/// Throws a std::runtime_error if the file can't be read.
+/// \param fileName The name/path of the file
+/// \param seed The seed of the hash
+/// \return The hash
+std::uint64_t hashFile(
+    const std::string& fileName,
+    const std::uint64_t seed = 0
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Formats a hash as 16 lower case hexadecimal digits
+/// \param hash The hash
+/// \return The hash in hexadecimal
+std::string formatHash(const std::uint64_t hash);
+
+} // utils
+} // lane
+
+#endif // LANE_UTILS_HASH_HPP
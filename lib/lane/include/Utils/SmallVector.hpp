@@ -0,0 +1,328 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file SmallVector.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A vector which keeps its first few elements inline, only
+/// allocating when it grows past them
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_UTILS_SMALLVECTOR_HPP
+#define LANE_UTILS_SMALLVECTOR_HPP
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+
+namespace lane {
+namespace utils {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A contiguous sequence container with room for N elements inside
+/// the object itself. Up to N elements it never allocates, past that it
+/// moves them into storage from its allocator and grows like a std::vector.
+/// Moving a small vector whose elements are still inline moves them one by
+/// one, so iterators and references into it don't survive being moved.
+/// \tparam T The element type
+/// \tparam N The number of elements kept inline
+/// \tparam Allocator The allocator used once the inline storage is full
+template <
+    typename T,
+    std::size_t N,
+    typename Allocator = std::allocator<T>
+>
+class SmallVector final {
+public:
+    typedef T value_type;
+    typedef Allocator allocator_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    static_assert(N > 0, "A SmallVector needs room for at least one element");
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param allocator The allocator to use once the inline storage is full
+    explicit SmallVector(const Allocator& allocator = Allocator()) noexcept
+    : allocator_(allocator),
+      data_(getInline()),
+      size_(0),
+      capacity_(N) {
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~SmallVector() noexcept {
+        clear();
+        release();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor. The copy uses the same allocator.
+    /// \param other Object to be copy constructed from
+    SmallVector(const SmallVector& other)
+    : SmallVector(other.allocator_) {
+        append(other.begin(), other.end());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor. Takes over the storage of the other vector if
+    /// it's been allocated, otherwise moves its elements.
+    /// \param other Object to be move constructed from
+    SmallVector(SmallVector&& other) noexcept
+    : SmallVector(other.allocator_) {
+        take(other);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator. Keeps this vector's allocator.
+    /// \param other Object to be copy assigned from
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            append(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator. Takes the other vector's allocator
+    /// along with its elements.
+    /// \param other Object to be move assigned from
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            clear();
+            release();
+            allocator_ = other.allocator_;
+            take(other);
+        }
+        return *this;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Equality operator
+    /// \param other Object to be compared against
+    bool operator==(const SmallVector& other) const {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Inequality operator
+    /// \param other Object to be compared against
+    bool operator!=(const SmallVector& other) const {
+        return !(*this == other);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the allocator used once the inline storage is full
+    /// \return A copy of the allocator
+    allocator_type get_allocator() const noexcept {
+        return allocator_;
+    }
+
+    // The rest of the interface is as for std::vector
+
+    iterator begin() noexcept {
+        return data_;
+    }
+
+    iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator begin() const noexcept {
+        return data_;
+    }
+
+    const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return data_;
+    }
+
+    const_iterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    pointer data() noexcept {
+        return data_;
+    }
+
+    const_pointer data() const noexcept {
+        return data_;
+    }
+
+    reference operator[](const size_type i) noexcept {
+        return data_[i];
+    }
+
+    const_reference operator[](const size_type i) const noexcept {
+        return data_[i];
+    }
+
+    reference front() noexcept {
+        return data_[0];
+    }
+
+    const_reference front() const noexcept {
+        return data_[0];
+    }
+
+    reference back() noexcept {
+        return data_[size_ - 1];
+    }
+
+    const_reference back() const noexcept {
+        return data_[size_ - 1];
+    }
+
+    bool empty() const noexcept {
+        return size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return size_;
+    }
+
+    size_type capacity() const noexcept {
+        return capacity_;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether the elements are still in the inline storage
+    /// \return Whether nothing has been allocated
+    bool isInline() const noexcept {
+        return data_ == getInline();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Makes room for at least the given number of elements
+    /// \param capacity The number of elements to make room for
+    void reserve(const size_type capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+        T* storage = AllocatorTraits::allocate(allocator_, capacity);
+        for (size_type i = 0; i < size_; ++i) {
+            new (storage + i) T(std::move_if_noexcept(data_[i]));
+            data_[i].~T();
+        }
+        release();
+        data_ = storage;
+        capacity_ = capacity;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructs an element in place at the end
+    /// \param args The arguments to construct the element with
+    template <typename... Args>
+    void emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            grow();
+        }
+        new (data_ + size_) T(std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() noexcept {
+        data_[--size_].~T();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destroys all the elements, keeping any allocated storage
+    void clear() noexcept {
+        for (size_type i = 0; i < size_; ++i) {
+            data_[i].~T();
+        }
+        size_ = 0;
+    }
+
+private:
+    typedef std::allocator_traits<Allocator> AllocatorTraits;
+
+    T* getInline() noexcept {
+        return reinterpret_cast<T*>(&inline_);
+    }
+
+    const T* getInline() const noexcept {
+        return reinterpret_cast<const T*>(&inline_);
+    }
+
+    // Doubles the capacity, as std::vector does
+    void grow() {
+        reserve(capacity_ * 2);
+    }
+
+    // Copies elements onto the end
+    void append(const_iterator first, const_iterator last) {
+        reserve(size_ + static_cast<size_type>(last - first));
+        for (; first != last; ++first) {
+            new (data_ + size_) T(*first);
+            ++size_;
+        }
+    }
+
+    // Gives any allocated storage back, once the elements are destroyed
+    void release() noexcept {
+        if (!isInline()) {
+            AllocatorTraits::deallocate(allocator_, data_, capacity_);
+            data_ = getInline();
+            capacity_ = N;
+        }
+    }
+
+    // Takes the elements of another vector, leaving it empty. This vector
+    // must be empty and inline, with the same allocator as the other. The
+    // elements' move constructors mustn't throw
+    void take(SmallVector& other) noexcept {
+        if (other.isInline()) {
+            for (size_type i = 0; i < other.size_; ++i) {
+                new (data_ + i) T(std::move(other.data_[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.getInline();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+
+    Allocator allocator_;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inline_;
+    T* data_;
+    size_type size_;
+    size_type capacity_;
+};
+
+} // utils
+} // lane
+
+#endif // LANE_UTILS_SMALLVECTOR_HPP
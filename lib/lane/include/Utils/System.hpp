@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file System.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Cross-platform process resource usage code
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_UTILS_SYSTEM_HPP
+#define LANE_UTILS_SYSTEM_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace lane {
+namespace utils {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the amount of memory the process currently has resident
+/// \return The resident memory in bytes, or 0 if it can't be found
+std::uint64_t getResidentMemory() noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the most memory the process has had resident at once
+/// \return The peak resident memory in bytes, or 0 if it can't be found
+std::uint64_t getPeakResidentMemory() noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the path of the running executable
+/// \return The path, or an empty string if it can't be found
+std::string getExecutablePath() noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A NUMA node and the CPUs on it
+struct NumaNode {
+    /// The number of the node, as the system knows it
+    unsigned int id;
+    /// The CPU numbers of the node's CPUs which the process may run on
+    std::vector<unsigned int> cpus;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the CPUs the process may run on, grouped by NUMA node. On
+/// Linux the nodes come from /sys/devices/system/node
+/// \return The nodes with CPUs the process may run on, in node order. All
+/// the CPUs are on a single node 0 where NUMA isn't supported or can't be
+/// found
+std::vector<NumaNode> getNumaNodes();
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Restricts the calling thread to running on the given CPUs
+/// \param cpus The CPU numbers
+/// \return True if the thread's affinity was set
+bool setThreadAffinity(const std::vector<unsigned int>& cpus) noexcept;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Asks for the memory the calling thread allocates from then on to
+/// come from a NUMA node where the platform allows it (a preferred memory
+/// policy on Linux). Memory otherwise comes from the node of the CPU which
+/// first touches it, so a thread bound to a node's CPUs mostly gets local
+/// memory anyway
+/// \param nodeID The number of the node
+/// \return True if the policy was set
+bool setThreadMemoryNode(const unsigned int nodeID) noexcept;
+
+} // utils
+} // lane
+
+#endif // LANE_UTILS_SYSTEM_HPP
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ThreadPool.hpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A pool of worker threads shared by the parallel parts of lane
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef LANE_UTILS_THREADPOOL_HPP
+#define LANE_UTILS_THREADPOOL_HPP
+
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+namespace lane {
+namespace utils {
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief How the threads of a pool are set up
+struct ThreadPoolSettings {
+    /// The number of threads, including the thread handing out the work
+    /// (0 for one per CPU the process may run on)
+    unsigned int threads = 0;
+    /// Pin each worker to a CPU of its own (shared round robin when there
+    /// are more workers than CPUs), so they don't migrate between cores
+    bool isPinning = false;
+    /// Spread the workers round robin over the NUMA nodes, binding each to
+    /// its node's CPUs and asking for its memory (arenas included, as they
+    /// allocate on first use) to come from that node
+    bool isNumaBinding = false;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A fixed set of worker threads which run the tasks of parallel
+/// loops. The thread running a loop works on it too, and only waits for
+/// the tasks it handed out, so a task can itself run a loop on the same
+/// pool without deadlocking. Each loop can be limited to fewer threads than
+/// the pool has, giving a worker count per stage.
+/// Everything in lane which runs in parallel uses the shared pool (see
+/// getShared), so that a process never runs more threads than it's set up
+/// for.
+class ThreadPool final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Starts the worker threads.
+    /// \param settings How to set up the threads
+    explicit ThreadPool(const ThreadPoolSettings& settings = ThreadPoolSettings());
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor. Stops the worker threads once they're idle.
+    ~ThreadPool() noexcept;
+
+    ThreadPool(const ThreadPool& other) = delete;
+
+    ThreadPool(ThreadPool&& other) = delete;
+
+    ThreadPool& operator=(const ThreadPool& other) = delete;
+
+    ThreadPool& operator=(ThreadPool&& other) = delete;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of threads work is spread over, counting the
+    /// thread running a loop
+    /// \return The number of threads
+    unsigned int getThreadCount() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Runs task(i) for every i from 0 to count - 1, spread over the
+    /// pool's threads, and waits for them all to finish. Tasks are handed out
+    /// in order, one at a time, as threads become free. If a task throws, no
+    /// more are started, and the first exception is thrown again once those
+    /// already running have finished.
+    /// \param count The number of tasks
+    /// \param task The function to run for each task
+    /// \param threads The most threads to run the tasks on, including the
+    /// calling thread (0 for all of the pool's threads)
+    void parallelFor(
+        const std::size_t count,
+        const std::function<void(std::size_t)>& task,
+        const unsigned int threads = 0
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the pool shared by the whole process, starting it with the
+    /// settings given to configureShared (or the defaults) if it hasn't been
+    /// already
+    /// \return The shared pool
+    static ThreadPool& getShared();
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Sets up the pool shared by the whole process, replacing the one
+    /// already running if there is one. Call this at start up, as it mustn't
+    /// be called while the shared pool is in use.
+    /// \param settings How to set up the threads
+    static void configureShared(const ThreadPoolSettings& settings);
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+} // utils
+} // lane
+
+#endif // LANE_UTILS_THREADPOOL_HPP
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file BackgroundModel.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A rolling per-pixel background model for subtracting from frames
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <map>
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include "Frame.hpp"
+#include "BackgroundModel.hpp"
+
+namespace lane {
+
+BackgroundModel::BackgroundModel(const double weight, const double minLevel)
+: weight_(weight),
+  minLevel_(minLevel) {
+    if (!(weight > 0.0 && weight <= 1.0)) {
+        throw std::runtime_error("Background weight must be in (0, 1]");
+    }
+}
+
+BackgroundModel::~BackgroundModel() noexcept = default;
+
+BackgroundModel::BackgroundModel(const BackgroundModel& other) = default;
+
+BackgroundModel::BackgroundModel(BackgroundModel&& other) = default;
+
+BackgroundModel& BackgroundModel::operator=(const BackgroundModel& other) = default;
+
+BackgroundModel& BackgroundModel::operator=(BackgroundModel&& other) = default;
+
+std::size_t BackgroundModel::subtract(const Frame& frame, Frame& subtracted) {
+    auto& background = channels_[frame.getChannelID()];
+    if (background.empty()) {
+        background.assign(256 * 256, 0.0f);
+    }
+
+    subtracted = Frame();
+    subtracted.setChannelID(frame.getChannelID());
+    subtracted.setTimeStamp(frame.getTimeStamp());
+    subtracted.setTimeStampSub(frame.getTimeStampSub());
+    std::size_t dropped = 0;
+    const auto minLevel = static_cast<float>(minLevel_);
+    for (const auto& p : frame.getPixels()) {
+        // Pixels off the detector have no background, and are dropped
+        if (p.second.getX() > 255 || p.second.getY() > 255) {
+            ++dropped;
+            continue;
+        }
+        const auto level = background[p.first];
+        std::int64_t c = p.second.getC();
+        if (level >= minLevel) {
+            c -= static_cast<std::int64_t>(std::lround(level));
+        }
+        if (c > 0) {
+            subtracted.setPixel(
+                p.second.getX(),
+                p.second.getY(),
+                static_cast<std::uint32_t>(c)
+            );
+        } else {
+            ++dropped;
+        }
+    }
+
+    // Decay every pixel in one branch free pass, then add in the hits
+    const auto keep = static_cast<float>(1.0 - weight_);
+    const auto weight = static_cast<float>(weight_);
+    float* levels = background.data();
+    for (std::size_t i = 0; i < 256 * 256; ++i) {
+        levels[i] *= keep;
+    }
+    for (const auto& p : frame.getPixels()) {
+        if (p.second.getX() < 256 && p.second.getY() < 256) {
+            levels[p.first] += weight * static_cast<float>(p.second.getC());
+        }
+    }
+    return dropped;
+}
+
+void BackgroundModel::clear() noexcept {
+    channels_.clear();
+}
+
+double BackgroundModel::getBackground(
+    const std::uint32_t channelID,
+    const std::uint32_t x,
+    const std::uint32_t y
+) const noexcept {
+    auto channel = channels_.find(channelID);
+    if (channel == channels_.end()) {
+        return 0.0;
+    }
+    return channel->second[x * 256 + y];
+}
+
+} // lane
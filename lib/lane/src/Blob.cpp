@@ -13,14 +13,21 @@
 
 #include <ostream>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 #include "Pixel.hpp"
 #include "Blob.hpp"
+#include "Utils/Arena.hpp"
 
 namespace lane {
 
 Blob::Blob() = default;
 
+Blob::Blob(utils::Arena& arena)
+: pixelKeys_(KeyList::allocator_type(arena)),
+  pixels_(PixelList::allocator_type(arena)) {
+}
+
 Blob::~Blob() noexcept = default;
 
 Blob::Blob(const Blob& other) = default;
@@ -35,7 +42,8 @@ bool Blob::operator==(const Blob& other) const noexcept {
     if (this != &other) {
         if(pixelKeys_.size() == other.pixelKeys_.size()) {
             return (
-                pixelKeys_ == other.pixelKeys_
+                pixelKeys_ == other.pixelKeys_ &&
+                pixels_ == other.pixels_
             );
         }
 
@@ -49,43 +57,57 @@ bool Blob::operator!=(const Blob& other) const noexcept {
     return !(*this == other);
 }
 
-std::vector<std::uint32_t>::iterator
+Blob::KeyList::iterator
 Blob::begin() noexcept {
     return pixelKeys_.begin();
 }
 
-std::vector<std::uint32_t>::iterator
+Blob::KeyList::iterator
 Blob::end() noexcept {
     return pixelKeys_.end();
 }
 
-std::vector<std::uint32_t>::const_iterator
+Blob::KeyList::const_iterator
 Blob::begin() const noexcept {
     return pixelKeys_.begin();
 }
 
-std::vector<std::uint32_t>::const_iterator
+Blob::KeyList::const_iterator
 Blob::end() const noexcept {
     return pixelKeys_.end();
 }
 
+const Blob::PixelList& Blob::getPixels() const noexcept {
+    return pixels_;
+}
+
+Blob::PixelList& Blob::getPixels() noexcept {
+    return pixels_;
+}
+
+std::size_t Blob::getSize() const noexcept {
+    return pixels_.size();
+}
+
 void Blob::addPixel(const Pixel& pixel) noexcept {
     pixelKeys_.emplace_back(pixel.getX() * 256 + pixel.getY());
+    pixels_.emplace_back(pixel);
 }
 
 void Blob::addPixelKey(const std::uint32_t key) noexcept {
     pixelKeys_.emplace_back(key);
+    pixels_.emplace_back(key / 256, key % 256);
 }
 
 void Blob::addPixels(const std::vector<Pixel>& pixels) noexcept {
     for (const auto& p : pixels) {
-        pixelKeys_.emplace_back(p.getX() * 256 + p.getY());
+        addPixel(p);
     }
 }
 
 void Blob::addPixelKeys(const std::vector<std::uint32_t>& keys) noexcept {
     for (const auto& k : keys) {
-        pixelKeys_.emplace_back(k);
+        addPixelKey(k);
     }
 }
 
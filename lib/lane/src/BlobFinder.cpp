@@ -12,29 +12,33 @@
 /// or read the 'LICENSE.md' file distributed with this code
 
 #include <vector>
+#include <utility>
 #include <cstdint>
 #include "Pixel.hpp"
 #include "Blob.hpp"
 #include "BlobFinder.hpp"
+#include "Utils/Arena.hpp"
 
 namespace lane {
 
 namespace {
 
-// Returns a list of all the pixels neighbouring the given pixel
-// threshold determines the minimum value including and above which the 
-// neighbour should be considered
-std::vector<Pixel> getNeighbours(
+// All possible neighbour directions
+const int xDirs[] = { -1, -1, -1,  0, 0,  1, 1, 1 };
+const int yDirs[] = { -1,  0,  1, -1, 1, -1, 0, 1 };
+
+// Fills the given array with the pixels neighbouring the given pixel
+// and returns the number of neighbours found
+unsigned int getNeighbours(
     const Frame& frame,
-    const Pixel& pixel
+    const Pixel& pixel,
+    Pixel (&neighbours)[8]
 ) noexcept {
-    std::vector<Pixel> neighbours;
+    unsigned int count = 0;
     
     // Iterate over all possible directions
     // whilst checking for x/y values outside of the possible number of pixels
-    std::vector<int> xDirs { -1, -1, -1,  0, 0,  1, 1, 1 };
-    std::vector<int> yDirs { -1,  0,  1, -1, 1, -1, 0, 1 };
-    for (unsigned int i = 0; i < xDirs.size() - 1; ++i) {
+    for (unsigned int i = 0; i < sizeof(xDirs) / sizeof(xDirs[0]) - 1; ++i) {
         auto px = pixel.getX();
         auto py = pixel.getY();
         
@@ -44,26 +48,25 @@ std::vector<Pixel> getNeighbours(
             !(py == 0 && yDirs[i] == -1) &&
             py + yDirs[i] < 256
         ) {
-            neighbours.emplace_back(
-                frame.getPixel(
-                    px + xDirs[i],
-                    py + yDirs[i]
-                )
+            neighbours[count++] = frame.getPixel(
+                px + xDirs[i],
+                py + yDirs[i]
             );
         }
     }
     
-    return neighbours;
-}
-
+    return count;
 }
 
-// Returns a list of the Blobs found in a given frame
-std::vector<Blob> findBlobs(
+// Finds the blobs in a frame and appends them to the given list.
+// The arena (if any) is used for every allocation made on the way
+template <typename BlobListType>
+void findBlobsInto(
     const Frame& frame,
-    const unsigned int threshold
+    const unsigned int threshold,
+    utils::Arena* arena,
+    BlobListType& blobList
 ) noexcept {
-    std::vector<Blob> blobList;
     // A map of boolean values as to whether the pixel has been added to a blob
     bool isBlobbed[256][256];
     for (unsigned int i = 0; i < 256; ++i) {
@@ -72,6 +75,8 @@ std::vector<Blob> findBlobs(
         }
     }
     
+    Pixel neighbours[8];
+    
     // Iterate over the pixels in the frame
     for (const auto& p : frame.getPixels()) {
         // Check if the pixel has already been added to a blob
@@ -82,18 +87,18 @@ std::vector<Blob> findBlobs(
             !isBlobbed[p.second.getX()][p.second.getY()]
         ) {
             // Add the pixel to a blob
-            std::vector<std::uint32_t> addedKeys;
-            addedKeys.emplace_back(p.first);
+            Blob blob = arena != nullptr ? Blob(*arena) : Blob();
+            blob.addPixel(p.second);
             isBlobbed[p.second.getX()][p.second.getY()] = true;
             
-            // Iterate over pixels in the blob
-            for (unsigned int i = 0; i < addedKeys.size(); ++i) {
+            // Iterate over pixels in the blob, which carries the pixel data
+            // itself so nothing needs to be looked up in the frame again
+            const auto& added = blob.getPixels();
+            for (unsigned int i = 0; i < added.size(); ++i) {
                 // Iterate over the neighbours of the pixel
-                auto neighbours = getNeighbours(
-                    frame,
-                    frame.getPixel(addedKeys[i])
-                );
-                for (const auto& n : neighbours) {
+                auto count = getNeighbours(frame, added[i], neighbours);
+                for (unsigned int j = 0; j < count; ++j) {
+                    const auto& n = neighbours[j];
                     // If the count value is above the threshold 
                     // and the neighbour hasn't been added to a blob
                     if (
@@ -101,22 +106,37 @@ std::vector<Blob> findBlobs(
                         !isBlobbed[n.getX()][n.getY()]
                     ) {
                         // Add the pixel to the blob adn set as considered
-                        addedKeys.emplace_back(n.getX() * 256 + n.getY());
+                        blob.addPixel(n);
                         isBlobbed[n.getX()][n.getY()] = true;
                     }
                 }
             }
             
-            // Add keys to a blob
-            Blob blob;
-            for (const auto k : addedKeys) {
-                blob.addPixelKey(k);
-            }
             // Add the blob to the list
-            blobList.emplace_back(blob);
+            blobList.emplace_back(std::move(blob));
         }
     }
+}
+
+}
 
+// Returns a list of the Blobs found in a given frame
+std::vector<Blob> findBlobs(
+    const Frame& frame,
+    const unsigned int threshold
+) noexcept {
+    std::vector<Blob> blobList;
+    findBlobsInto(frame, threshold, nullptr, blobList);
+    return blobList;
+}
+
+BlobList findBlobs(
+    const Frame& frame,
+    utils::Arena& arena,
+    const unsigned int threshold
+) noexcept {
+    BlobList blobList{BlobList::allocator_type(arena)};
+    findBlobsInto(frame, threshold, &arena, blobList);
     return blobList;
 }
 
@@ -0,0 +1,352 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ClusterTable.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Block based columnar storage for cluster analysis results, and
+/// queries over it
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include "ClusterTable.hpp"
+
+// Binary format, in native byte order:
+// 4 bytes - magic 'LCTB'
+// 4 bytes - version
+// 4 bytes - number of columns
+// columns - name length (4 bytes) followed by the name
+// blocks  - number of rows (8 bytes), the minimum of each column, the
+// maximum of each column, then the values of each column in turn
+// (8 byte doubles). NaN values are left out of the minimum/maximum.
+
+namespace {
+
+const char tableMagic[4] = { 'L', 'C', 'T', 'B' };
+const std::uint32_t tableVersion = 1;
+
+// The parts of a table header needed to read the blocks
+struct TableHeader {
+    std::vector<std::string> columns;
+};
+
+TableHeader readHeader(std::ifstream& input, const std::string& fileName) {
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t columnCount = 0;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    input.read(reinterpret_cast<char*>(&columnCount), sizeof(columnCount));
+    if (
+        !input ||
+        std::memcmp(magic, tableMagic, sizeof(magic)) != 0 ||
+        version != tableVersion
+    ) {
+        throw std::runtime_error("Not a valid LANE cluster table: " + fileName);
+    }
+
+    TableHeader header;
+    for (std::uint32_t i = 0; i < columnCount && input; ++i) {
+        std::uint32_t length = 0;
+        input.read(reinterpret_cast<char*>(&length), sizeof(length));
+        std::string name(length, '\0');
+        input.read(&name[0], length);
+        header.columns.emplace_back(name);
+    }
+    if (!input) {
+        throw std::runtime_error("Truncated LANE cluster table: " + fileName);
+    }
+    return header;
+}
+
+std::size_t getColumnIndex(
+    const std::vector<std::string>& columns,
+    const std::string& column,
+    const std::string& fileName
+) {
+    auto it = std::find(columns.begin(), columns.end(), column);
+    if (it == columns.end()) {
+        throw std::runtime_error(
+            "No column named '" + column + "' in " + fileName
+        );
+    }
+    return it - columns.begin();
+}
+
+}
+
+namespace lane {
+
+ClusterTableWriter::ClusterTableWriter(
+    const std::string& fileName,
+    const std::vector<std::string>& columns,
+    const std::size_t blockSize
+)
+: fileName_(fileName),
+  columns_(columns),
+  blockSize_(std::max<std::size_t>(blockSize, 1)),
+  rows_(0) {
+    output_.open(fileName, std::ios::trunc | std::ios::binary | std::ios::out);
+    if (!output_.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    std::uint32_t columnCount = columns_.size();
+    output_.write(tableMagic, sizeof(tableMagic));
+    output_.write(reinterpret_cast<const char*>(&tableVersion), sizeof(tableVersion));
+    output_.write(reinterpret_cast<const char*>(&columnCount), sizeof(columnCount));
+    for (const auto& column : columns_) {
+        std::uint32_t length = column.size();
+        output_.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        output_.write(column.data(), length);
+    }
+    block_.resize(columns_.size() * blockSize_);
+}
+
+ClusterTableWriter::~ClusterTableWriter() noexcept {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void ClusterTableWriter::addRow(const double* values) {
+    if (!output_.is_open()) {
+        throw std::runtime_error("Cluster table is closed: " + fileName_);
+    }
+    for (std::size_t c = 0; c < columns_.size(); ++c) {
+        block_[c * blockSize_ + rows_] = values[c];
+    }
+    if (++rows_ == blockSize_) {
+        writeBlock();
+    }
+}
+
+void ClusterTableWriter::addRow(const std::vector<double>& values) {
+    if (values.size() != columns_.size()) {
+        throw std::runtime_error(
+            "Wrong number of values in cluster table row: " + fileName_
+        );
+    }
+    addRow(values.data());
+}
+
+void ClusterTableWriter::close() {
+    if (!output_.is_open()) {
+        return;
+    }
+    writeBlock();
+    output_.close();
+    if (output_.fail()) {
+        throw std::runtime_error("Unable to write file: " + fileName_);
+    }
+}
+
+const std::vector<std::string>& ClusterTableWriter::getColumns() const noexcept {
+    return columns_;
+}
+
+void ClusterTableWriter::writeBlock() {
+    if (rows_ == 0) {
+        return;
+    }
+
+    std::vector<double> minimums(columns_.size(), std::numeric_limits<double>::infinity());
+    std::vector<double> maximums(columns_.size(), -std::numeric_limits<double>::infinity());
+    for (std::size_t c = 0; c < columns_.size(); ++c) {
+        const double* values = &block_[c * blockSize_];
+        for (std::size_t r = 0; r < rows_; ++r) {
+            // Comparisons with NaN are false, so NaN never becomes the min/max
+            if (values[r] < minimums[c]) {
+                minimums[c] = values[r];
+            }
+            if (values[r] > maximums[c]) {
+                maximums[c] = values[r];
+            }
+        }
+    }
+
+    std::uint64_t rowCount = rows_;
+    output_.write(reinterpret_cast<const char*>(&rowCount), sizeof(rowCount));
+    output_.write(
+        reinterpret_cast<const char*>(minimums.data()),
+        minimums.size() * sizeof(double)
+    );
+    output_.write(
+        reinterpret_cast<const char*>(maximums.data()),
+        maximums.size() * sizeof(double)
+    );
+    for (std::size_t c = 0; c < columns_.size(); ++c) {
+        output_.write(
+            reinterpret_cast<const char*>(&block_[c * blockSize_]),
+            rows_ * sizeof(double)
+        );
+    }
+    rows_ = 0;
+}
+
+
+std::size_t QueryResult::getRowCount() const noexcept {
+    return values.empty() ? 0 : values.front().size();
+}
+
+
+ClusterQuery::ClusterQuery() = default;
+
+ClusterQuery::~ClusterQuery() noexcept = default;
+
+ClusterQuery::ClusterQuery(const ClusterQuery& other) = default;
+
+ClusterQuery::ClusterQuery(ClusterQuery&& other) = default;
+
+ClusterQuery& ClusterQuery::operator=(const ClusterQuery& other) = default;
+
+ClusterQuery& ClusterQuery::operator=(ClusterQuery&& other) = default;
+
+ClusterQuery& ClusterQuery::select(const std::vector<std::string>& columns) {
+    columns_ = columns;
+    return *this;
+}
+
+ClusterQuery& ClusterQuery::where(
+    const std::string& column,
+    const double min,
+    const double max
+) {
+    RangePredicate predicate;
+    predicate.column = column;
+    predicate.min = min;
+    predicate.max = max;
+    predicates_.emplace_back(predicate);
+    return *this;
+}
+
+void ClusterQuery::run(const std::string& fileName, QueryResult& result) const {
+    std::ifstream input(fileName, std::ios::binary | std::ios::in);
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+    auto header = readHeader(input, fileName);
+    const auto columnCount = header.columns.size();
+
+    // Work out which columns are output and which are needed at all
+    const auto& selected = columns_.empty() ? header.columns : columns_;
+    std::vector<std::size_t> outputs;
+    for (const auto& column : selected) {
+        outputs.emplace_back(getColumnIndex(header.columns, column, fileName));
+    }
+    std::vector<std::size_t> conditions;
+    for (const auto& predicate : predicates_) {
+        conditions.emplace_back(
+            getColumnIndex(header.columns, predicate.column, fileName)
+        );
+    }
+    std::vector<bool> isNeeded(columnCount, false);
+    for (const auto c : outputs) {
+        isNeeded[c] = true;
+    }
+    for (const auto c : conditions) {
+        isNeeded[c] = true;
+    }
+
+    if (result.columns.empty() && result.values.empty()) {
+        result.columns = selected;
+        result.values.resize(selected.size());
+    } else if (result.columns != selected) {
+        throw std::runtime_error(
+            "Columns of " + fileName + " don't match the earlier tables"
+        );
+    }
+
+    std::vector<double> minimums(columnCount);
+    std::vector<double> maximums(columnCount);
+    std::vector<std::vector<double>> columns(columnCount);
+    std::vector<char> isMatch;
+    std::uint64_t rowCount = 0;
+    while (input.read(reinterpret_cast<char*>(&rowCount), sizeof(rowCount))) {
+        input.read(
+            reinterpret_cast<char*>(minimums.data()),
+            columnCount * sizeof(double)
+        );
+        input.read(
+            reinterpret_cast<char*>(maximums.data()),
+            columnCount * sizeof(double)
+        );
+        if (!input) {
+            throw std::runtime_error("Truncated LANE cluster table: " + fileName);
+        }
+        const auto dataStart = input.tellg();
+        const std::streamoff columnSize = rowCount * sizeof(double);
+
+        // Skip the whole block if its statistics rule out every row
+        bool isSkipped = false;
+        for (std::size_t i = 0; i < predicates_.size(); ++i) {
+            const auto c = conditions[i];
+            if (
+                maximums[c] < predicates_[i].min ||
+                minimums[c] > predicates_[i].max
+            ) {
+                isSkipped = true;
+                break;
+            }
+        }
+        if (isSkipped) {
+            ++result.blocksSkipped;
+            input.seekg(dataStart + columnSize * static_cast<std::streamoff>(columnCount));
+            continue;
+        }
+        ++result.blocksScanned;
+
+        // Only read the columns that are used
+        for (std::size_t c = 0; c < columnCount; ++c) {
+            if (!isNeeded[c]) {
+                continue;
+            }
+            columns[c].resize(rowCount);
+            input.seekg(dataStart + columnSize * static_cast<std::streamoff>(c));
+            input.read(reinterpret_cast<char*>(columns[c].data()), columnSize);
+        }
+        if (!input) {
+            throw std::runtime_error("Truncated LANE cluster table: " + fileName);
+        }
+        input.seekg(dataStart + columnSize * static_cast<std::streamoff>(columnCount));
+
+        isMatch.assign(rowCount, 1);
+        for (std::size_t i = 0; i < predicates_.size(); ++i) {
+            const double* values = columns[conditions[i]].data();
+            const double min = predicates_[i].min;
+            const double max = predicates_[i].max;
+            for (std::uint64_t r = 0; r < rowCount; ++r) {
+                isMatch[r] &= values[r] >= min && values[r] <= max;
+            }
+        }
+        for (std::size_t o = 0; o < outputs.size(); ++o) {
+            const auto& values = columns[outputs[o]];
+            auto& out = result.values[o];
+            for (std::uint64_t r = 0; r < rowCount; ++r) {
+                if (isMatch[r]) {
+                    out.emplace_back(values[r]);
+                }
+            }
+        }
+    }
+}
+
+QueryResult ClusterQuery::run(const std::string& fileName) const {
+    QueryResult result;
+    run(fileName, result);
+    return result;
+}
+
+} // lane
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file DuplicateFrameFilter.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Spotting frames repeated in a stream of frames
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <vector>
+#include <unordered_set>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "Frame.hpp"
+#include "DuplicateFrameFilter.hpp"
+
+namespace lane {
+
+const std::size_t DuplicateFrameFilter::defaultCapacity;
+
+DuplicateFrameFilter::DuplicateFrameFilter(const std::size_t capacity)
+: capacity_(std::max<std::size_t>(capacity, 1)),
+  seen_(),
+  recent_(),
+  position_(0),
+  duplicateCount_(0) {
+}
+
+DuplicateFrameFilter::~DuplicateFrameFilter() noexcept = default;
+
+DuplicateFrameFilter::DuplicateFrameFilter(
+    const DuplicateFrameFilter& other
+) = default;
+
+DuplicateFrameFilter::DuplicateFrameFilter(
+    DuplicateFrameFilter&& other
+) = default;
+
+DuplicateFrameFilter& DuplicateFrameFilter::operator=(
+    const DuplicateFrameFilter& other
+) = default;
+
+DuplicateFrameFilter& DuplicateFrameFilter::operator=(
+    DuplicateFrameFilter&& other
+) = default;
+
+bool DuplicateFrameFilter::isDuplicate(const Frame& frame) {
+    return isDuplicate(frame.getFingerprint());
+}
+
+bool DuplicateFrameFilter::isDuplicate(const std::uint64_t fingerprint) {
+    if (!seen_.insert(fingerprint).second) {
+        ++duplicateCount_;
+        return true;
+    }
+
+    // Once full, the oldest fingerprint makes way for the new one
+    if (recent_.size() < capacity_) {
+        recent_.emplace_back(fingerprint);
+    } else {
+        seen_.erase(recent_[position_]);
+        recent_[position_] = fingerprint;
+        position_ = (position_ + 1) % capacity_;
+    }
+    return false;
+}
+
+void DuplicateFrameFilter::clear() noexcept {
+    seen_.clear();
+    recent_.clear();
+    position_ = 0;
+}
+
+std::uint64_t DuplicateFrameFilter::getDuplicateCount() const noexcept {
+    return duplicateCount_;
+}
+
+} // lane
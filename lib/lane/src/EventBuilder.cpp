@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file EventBuilder.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Joins the frames of several channels into multi-chip events
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <stdexcept>
+#include <cstdint>
+#include "EventBuilder.hpp"
+#include "LaneFileReader.hpp"
+#include "LaneIndex.hpp"
+#include "Utils/Misc.hpp"
+
+namespace {
+
+// Orders frames by time stamp, then sub second time stamp
+bool isEarlier(const lane::Frame& lhs, const lane::Frame& rhs) noexcept {
+    return lhs.getTimeStamp() < rhs.getTimeStamp() || (
+        lhs.getTimeStamp() == rhs.getTimeStamp() &&
+        lhs.getTimeStampSub() < rhs.getTimeStampSub()
+    );
+}
+
+}
+
+namespace lane {
+
+EventBuilder::EventBuilder() noexcept
+: isStarted_(false) {
+}
+
+EventBuilder::~EventBuilder() noexcept = default;
+
+EventBuilder::EventBuilder(EventBuilder&& other) = default;
+
+EventBuilder& EventBuilder::operator=(EventBuilder&& other) = default;
+
+void EventBuilder::addSource(std::unique_ptr<FrameSource> source) {
+    if (isStarted_) {
+        throw std::runtime_error("Can't add frame sources to a started EventBuilder");
+    }
+    heads_.push_back(Head{ std::move(source), Frame(), false });
+}
+
+void EventBuilder::addLaneFile(const std::string& fileName) {
+    auto index = LaneIndex::load(fileName);
+    for (const auto channelID : index.getChannelIDs()) {
+        addSource(utils::make_unique<LaneFileReader>(fileName, index, channelID));
+    }
+}
+
+bool EventBuilder::next(Event& event) {
+    if (!isStarted_) {
+        for (auto& head : heads_) {
+            head.hasFrame = head.source->next(head.frame);
+        }
+        isStarted_ = true;
+    }
+
+    // Find the earliest frame waiting in any of the streams
+    const Frame* earliest = nullptr;
+    for (const auto& head : heads_) {
+        if (head.hasFrame && (earliest == nullptr || isEarlier(head.frame, *earliest))) {
+            earliest = &head.frame;
+        }
+    }
+    if (earliest == nullptr) {
+        return false;
+    }
+    event.timeStamp = earliest->getTimeStamp();
+    event.timeStampSub = earliest->getTimeStampSub();
+    event.frames.clear();
+
+    // Take every frame from that exposure, moving those streams on
+    for (auto& head : heads_) {
+        if (
+            head.hasFrame &&
+            head.frame.getTimeStamp() == event.timeStamp &&
+            head.frame.getTimeStampSub() == event.timeStampSub
+        ) {
+            event.frames.emplace_back(std::move(head.frame));
+            head.hasFrame = head.source->next(head.frame);
+        }
+    }
+    return true;
+}
+
+} // lane
@@ -12,12 +12,30 @@
 /// or read the 'LICENSE.md' file distributed with this code
 
 #include <ostream>
+#include <cstddef>
 #include <cstdint>
+#include "Utils/Hash.hpp"
 #include "Frame.hpp"
 #include "Pixel.hpp"
 
 namespace lane {
 
+namespace {
+
+// Writes a word into a buffer little endian first, so fingerprints are the
+// same on every platform
+void putWord(unsigned char* buffer, const std::uint32_t value) noexcept {
+    buffer[0] = static_cast<unsigned char>(value);
+    buffer[1] = static_cast<unsigned char>(value >> 8);
+    buffer[2] = static_cast<unsigned char>(value >> 16);
+    buffer[3] = static_cast<unsigned char>(value >> 24);
+}
+
+// The pixels are hashed this many at a time
+const std::size_t fingerprintBlockPixels = 64;
+
+}
+
 Frame::Frame() noexcept
 : channel_(0),
   timeStamp_(0),
@@ -111,6 +129,30 @@ const std::map<std::uint32_t, Pixel>& Frame::getPixels() const noexcept {
     return pixels_;
 }
 
+std::uint64_t Frame::getFingerprint() const noexcept {
+    unsigned char buffer[fingerprintBlockPixels * 8];
+    putWord(buffer, channel_);
+    putWord(buffer + 4, timeStamp_);
+    putWord(buffer + 8, timeStampSub_);
+    putWord(buffer + 12, static_cast<std::uint32_t>(pixels_.size()));
+    utils::Hash64 hash;
+    hash.update(buffer, 16);
+
+    // The pixels are in key order, so equal frames hash them the same way
+    std::size_t size = 0;
+    for (const auto& p : pixels_) {
+        putWord(buffer + size, p.first);
+        putWord(buffer + size + 4, p.second.getC());
+        size += 8;
+        if (size == sizeof(buffer)) {
+            hash.update(buffer, size);
+            size = 0;
+        }
+    }
+    hash.update(buffer, size);
+    return hash.getDigest();
+}
+
 std::ostream& operator<<(std::ostream& os, const Frame& frame) noexcept {
     os << "Channel: " << frame.channel_ << "\n"
         << "Time Stamp: " << frame.timeStamp_ << "\n"
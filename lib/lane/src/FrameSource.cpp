@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file FrameSource.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A frame source parent class and an in memory frame source
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <vector>
+#include <utility>
+#include "FrameSource.hpp"
+
+namespace lane {
+
+// FrameSource implementations
+FrameSource::~FrameSource() = default;
+
+
+// FrameListSource implementations
+FrameListSource::FrameListSource(std::vector<Frame> frames)
+: frames_(std::move(frames)),
+  position_(0) {
+}
+
+FrameListSource::~FrameListSource() = default;
+
+bool FrameListSource::next(Frame& frame) {
+    if (position_ >= frames_.size()) {
+        return false;
+    }
+    frame = std::move(frames_[position_++]);
+    return true;
+}
+
+} // lane
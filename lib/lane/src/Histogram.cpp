@@ -0,0 +1,347 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Histogram.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Mergeable fixed and logarithmic bin histograms
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include "Histogram.hpp"
+
+namespace {
+
+const char histogramMagic[4] = { 'L', 'H', 'S', 'T' };
+const std::uint32_t histogramVersion = 1;
+
+std::string formatNumber(const double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    return buffer;
+}
+
+}
+
+namespace lane {
+
+Histogram::Histogram() noexcept
+: binning_(Binning::Linear),
+  min_(0),
+  max_(0),
+  start_(0),
+  width_(0),
+  scale_(0),
+  underflow_(0),
+  overflow_(0) {
+}
+
+Histogram::Histogram(
+    const std::string& name,
+    const std::size_t binCount,
+    const double min,
+    const double max,
+    const Binning binning
+)
+: name_(name),
+  binning_(binning),
+  min_(min),
+  max_(max),
+  counts_(binCount, 0),
+  underflow_(0),
+  overflow_(0) {
+    if (binCount == 0 || !(min < max)) {
+        throw std::runtime_error("Invalid binning for histogram: " + name);
+    }
+    if (binning_ == Binning::Logarithmic) {
+        if (min <= 0) {
+            throw std::runtime_error(
+                "Logarithmic histogram needs a positive minimum: " + name
+            );
+        }
+        start_ = std::log(min);
+        width_ = (std::log(max) - start_) / binCount;
+    } else {
+        start_ = min;
+        width_ = (max - min) / binCount;
+    }
+    scale_ = 1 / width_;
+}
+
+Histogram::~Histogram() noexcept = default;
+
+Histogram::Histogram(const Histogram& other) = default;
+
+Histogram::Histogram(Histogram&& other) = default;
+
+Histogram& Histogram::operator=(const Histogram& other) = default;
+
+Histogram& Histogram::operator=(Histogram&& other) = default;
+
+void Histogram::fill(const double value) noexcept {
+    if (value < min_) {
+        ++underflow_;
+        return;
+    }
+    if (value >= max_) {
+        ++overflow_;
+        return;
+    }
+    if (value != value) {
+        return;
+    }
+    double position = binning_ == Binning::Logarithmic ?
+        (std::log(value) - start_) * scale_ :
+        (value - start_) * scale_;
+    // Rounding can push values just below max into a bin past the end
+    std::size_t bin = static_cast<std::size_t>(position);
+    if (bin >= counts_.size()) {
+        bin = counts_.size() - 1;
+    }
+    ++counts_[bin];
+}
+
+void Histogram::fill(const double* values, const std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        fill(values[i]);
+    }
+}
+
+void Histogram::merge(const Histogram& other) {
+    if (
+        other.binning_ != binning_ ||
+        other.counts_.size() != counts_.size() ||
+        other.min_ != min_ ||
+        other.max_ != max_
+    ) {
+        throw std::runtime_error(
+            "Can't merge histograms with different binning: " + name_
+        );
+    }
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    underflow_ += other.underflow_;
+    overflow_ += other.overflow_;
+}
+
+void Histogram::clear() noexcept {
+    counts_.assign(counts_.size(), 0);
+    underflow_ = 0;
+    overflow_ = 0;
+}
+
+const std::string& Histogram::getName() const noexcept {
+    return name_;
+}
+
+Histogram::Binning Histogram::getBinning() const noexcept {
+    return binning_;
+}
+
+std::size_t Histogram::getBinCount() const noexcept {
+    return counts_.size();
+}
+
+double Histogram::getMin() const noexcept {
+    return min_;
+}
+
+double Histogram::getMax() const noexcept {
+    return max_;
+}
+
+double Histogram::getBinEdge(const std::size_t bin) const noexcept {
+    if (bin == 0) {
+        return min_;
+    }
+    if (bin >= counts_.size()) {
+        return max_;
+    }
+    double edge = start_ + bin * width_;
+    return binning_ == Binning::Logarithmic ? std::exp(edge) : edge;
+}
+
+std::uint64_t Histogram::getCount(const std::size_t bin) const noexcept {
+    return counts_[bin];
+}
+
+std::uint64_t Histogram::getUnderflow() const noexcept {
+    return underflow_;
+}
+
+std::uint64_t Histogram::getOverflow() const noexcept {
+    return overflow_;
+}
+
+std::uint64_t Histogram::getEntries() const noexcept {
+    std::uint64_t entries = underflow_ + overflow_;
+    for (const auto count : counts_) {
+        entries += count;
+    }
+    return entries;
+}
+
+
+void mergeHistograms(
+    std::vector<Histogram>& histograms,
+    const std::vector<Histogram>& others
+) {
+    if (histograms.empty()) {
+        histograms = others;
+        return;
+    }
+    if (histograms.size() != others.size()) {
+        throw std::runtime_error("Can't merge different sets of histograms");
+    }
+    for (std::size_t i = 0; i < histograms.size(); ++i) {
+        histograms[i].merge(others[i]);
+    }
+}
+
+// Binary format, in native byte order:
+// 4 bytes - magic 'LHST'
+// 4 bytes - version
+// 4 bytes - number of histograms
+// histograms - name length (4 bytes) followed by the name, binning (4 bytes),
+// number of bins (4 bytes), min and max (8 byte doubles), underflow and
+// overflow (8 bytes each), then the count of each bin (8 bytes each)
+std::vector<Histogram> readHistograms(const std::string& fileName) {
+    std::ifstream input(fileName, std::ios::binary | std::ios::in);
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    input.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (
+        !input ||
+        std::memcmp(magic, histogramMagic, sizeof(magic)) != 0 ||
+        version != histogramVersion
+    ) {
+        throw std::runtime_error("Not a valid LANE histogram file: " + fileName);
+    }
+
+    std::vector<Histogram> histograms;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::uint32_t length = 0;
+        input.read(reinterpret_cast<char*>(&length), sizeof(length));
+        std::string name(length, '\0');
+        input.read(&name[0], length);
+        std::uint32_t binning = 0;
+        std::uint32_t binCount = 0;
+        double min = 0;
+        double max = 0;
+        input.read(reinterpret_cast<char*>(&binning), sizeof(binning));
+        input.read(reinterpret_cast<char*>(&binCount), sizeof(binCount));
+        input.read(reinterpret_cast<char*>(&min), sizeof(min));
+        input.read(reinterpret_cast<char*>(&max), sizeof(max));
+        if (!input) {
+            break;
+        }
+        Histogram histogram(
+            name,
+            binCount,
+            min,
+            max,
+            static_cast<Histogram::Binning>(binning)
+        );
+        input.read(reinterpret_cast<char*>(&histogram.underflow_), sizeof(histogram.underflow_));
+        input.read(reinterpret_cast<char*>(&histogram.overflow_), sizeof(histogram.overflow_));
+        input.read(
+            reinterpret_cast<char*>(histogram.counts_.data()),
+            histogram.counts_.size() * sizeof(std::uint64_t)
+        );
+        histograms.emplace_back(std::move(histogram));
+    }
+    if (!input) {
+        throw std::runtime_error("Truncated LANE histogram file: " + fileName);
+    }
+    return histograms;
+}
+
+void writeHistograms(
+    const std::string& fileName,
+    const std::vector<Histogram>& histograms
+) {
+    std::ofstream output(
+        fileName,
+        std::ios::trunc | std::ios::binary | std::ios::out
+    );
+    if (!output.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    std::uint32_t count = histograms.size();
+    output.write(histogramMagic, sizeof(histogramMagic));
+    output.write(reinterpret_cast<const char*>(&histogramVersion), sizeof(histogramVersion));
+    output.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& histogram : histograms) {
+        std::uint32_t length = histogram.getName().size();
+        std::uint32_t binning = static_cast<std::uint32_t>(histogram.getBinning());
+        std::uint32_t binCount = histogram.getBinCount();
+        double min = histogram.getMin();
+        double max = histogram.getMax();
+        std::uint64_t underflow = histogram.getUnderflow();
+        std::uint64_t overflow = histogram.getOverflow();
+        output.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        output.write(histogram.getName().data(), length);
+        output.write(reinterpret_cast<const char*>(&binning), sizeof(binning));
+        output.write(reinterpret_cast<const char*>(&binCount), sizeof(binCount));
+        output.write(reinterpret_cast<const char*>(&min), sizeof(min));
+        output.write(reinterpret_cast<const char*>(&max), sizeof(max));
+        output.write(reinterpret_cast<const char*>(&underflow), sizeof(underflow));
+        output.write(reinterpret_cast<const char*>(&overflow), sizeof(overflow));
+        for (std::size_t i = 0; i < binCount; ++i) {
+            std::uint64_t binValue = histogram.getCount(i);
+            output.write(reinterpret_cast<const char*>(&binValue), sizeof(binValue));
+        }
+    }
+    if (!output) {
+        throw std::runtime_error("Unable to write file: " + fileName);
+    }
+}
+
+void writeHistogramsCsv(
+    const std::string& fileName,
+    const std::vector<Histogram>& histograms
+) {
+    std::ofstream output(fileName, std::ios::trunc | std::ios::out);
+    if (!output.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    output << "Histogram,Low,High,Count\n";
+    for (const auto& histogram : histograms) {
+        const auto& name = histogram.getName();
+        output << name << ",-inf," << formatNumber(histogram.getMin())
+            << "," << histogram.getUnderflow() << "\n";
+        for (std::size_t i = 0; i < histogram.getBinCount(); ++i) {
+            output << name << "," << formatNumber(histogram.getBinEdge(i))
+                << "," << formatNumber(histogram.getBinEdge(i + 1))
+                << "," << histogram.getCount(i) << "\n";
+        }
+        output << name << "," << formatNumber(histogram.getMax())
+            << ",inf," << histogram.getOverflow() << "\n";
+    }
+    if (!output) {
+        throw std::runtime_error("Unable to write file: " + fileName);
+    }
+}
+
+} // lane
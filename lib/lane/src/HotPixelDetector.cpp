@@ -0,0 +1,269 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file HotPixelDetector.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Streaming detection of hot (noisy) pixels
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <map>
+#include <vector>
+#include <string>
+#include <utility>
+#include <fstream>
+#include <stdexcept>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include "Frame.hpp"
+#include "PixelMask.hpp"
+#include "HotPixelDetector.hpp"
+
+namespace lane {
+
+namespace {
+
+const char statisticsMagic[4] = { 'L', 'H', 'P', 'S' };
+const std::uint32_t statisticsVersion = 1;
+
+}
+
+HotPixelDetector::ChannelStatistics::ChannelStatistics()
+: frames(0),
+  hits(256 * 256, 0),
+  countSums(256 * 256, 0),
+  countSquareSums(256 * 256, 0) {
+}
+
+HotPixelDetector::HotPixelDetector() = default;
+
+HotPixelDetector::~HotPixelDetector() noexcept = default;
+
+HotPixelDetector::HotPixelDetector(const HotPixelDetector& other) = default;
+
+HotPixelDetector::HotPixelDetector(HotPixelDetector&& other) = default;
+
+HotPixelDetector& HotPixelDetector::operator=(const HotPixelDetector& other) = default;
+
+HotPixelDetector& HotPixelDetector::operator=(HotPixelDetector&& other) = default;
+
+void HotPixelDetector::addFrame(const Frame& frame) {
+    auto& stats = channels_[frame.getChannelID()];
+    ++stats.frames;
+    for (const auto& p : frame.getPixels()) {
+        std::uint64_t c = p.second.getC();
+        // Pixels off the detector have no place in the statistics
+        if (c == 0 || p.second.getX() > 255 || p.second.getY() > 255) {
+            continue;
+        }
+        ++stats.hits[p.first];
+        stats.countSums[p.first] += c;
+        stats.countSquareSums[p.first] += c * c;
+    }
+}
+
+void HotPixelDetector::merge(const HotPixelDetector& other) {
+    for (const auto& channel : other.channels_) {
+        auto& stats = channels_[channel.first];
+        stats.frames += channel.second.frames;
+        for (unsigned int i = 0; i < 256 * 256; ++i) {
+            stats.hits[i] += channel.second.hits[i];
+            stats.countSums[i] += channel.second.countSums[i];
+            stats.countSquareSums[i] += channel.second.countSquareSums[i];
+        }
+    }
+}
+
+void HotPixelDetector::write(const std::string& fileName) const {
+    std::ofstream output(
+        fileName,
+        std::ios::trunc | std::ios::binary | std::ios::out
+    );
+    if (!output.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    std::uint32_t count = channels_.size();
+    output.write(statisticsMagic, sizeof(statisticsMagic));
+    output.write(reinterpret_cast<const char*>(&statisticsVersion), sizeof(statisticsVersion));
+    output.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& channel : channels_) {
+        const auto& stats = channel.second;
+        std::uint32_t pixelCount = 0;
+        for (const auto hits : stats.hits) {
+            pixelCount += hits != 0;
+        }
+        output.write(reinterpret_cast<const char*>(&channel.first), sizeof(channel.first));
+        output.write(reinterpret_cast<const char*>(&stats.frames), sizeof(stats.frames));
+        output.write(reinterpret_cast<const char*>(&pixelCount), sizeof(pixelCount));
+        for (std::uint32_t i = 0; i < 256 * 256; ++i) {
+            if (stats.hits[i] == 0) {
+                continue;
+            }
+            output.write(reinterpret_cast<const char*>(&i), sizeof(i));
+            output.write(reinterpret_cast<const char*>(&stats.hits[i]), sizeof(stats.hits[i]));
+            output.write(reinterpret_cast<const char*>(&stats.countSums[i]), sizeof(stats.countSums[i]));
+            output.write(reinterpret_cast<const char*>(&stats.countSquareSums[i]), sizeof(stats.countSquareSums[i]));
+        }
+    }
+    if (!output) {
+        throw std::runtime_error("Unable to write file: " + fileName);
+    }
+}
+
+void HotPixelDetector::read(const std::string& fileName) {
+    std::ifstream input(fileName, std::ios::binary | std::ios::in);
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    input.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (
+        !input ||
+        std::memcmp(magic, statisticsMagic, sizeof(magic)) != 0 ||
+        version != statisticsVersion
+    ) {
+        throw std::runtime_error("Not a valid LANE hot pixel statistics file: " + fileName);
+    }
+
+    std::map<std::uint32_t, ChannelStatistics> channels;
+    for (std::uint32_t c = 0; c < count; ++c) {
+        std::uint32_t channelID = 0;
+        std::uint32_t pixelCount = 0;
+        input.read(reinterpret_cast<char*>(&channelID), sizeof(channelID));
+        auto& stats = channels[channelID];
+        input.read(reinterpret_cast<char*>(&stats.frames), sizeof(stats.frames));
+        input.read(reinterpret_cast<char*>(&pixelCount), sizeof(pixelCount));
+        for (std::uint32_t p = 0; p < pixelCount && input; ++p) {
+            std::uint32_t i = 0;
+            input.read(reinterpret_cast<char*>(&i), sizeof(i));
+            if (i >= 256 * 256) {
+                throw std::runtime_error("Pixel out of range in hot pixel statistics file: " + fileName);
+            }
+            input.read(reinterpret_cast<char*>(&stats.hits[i]), sizeof(stats.hits[i]));
+            input.read(reinterpret_cast<char*>(&stats.countSums[i]), sizeof(stats.countSums[i]));
+            input.read(reinterpret_cast<char*>(&stats.countSquareSums[i]), sizeof(stats.countSquareSums[i]));
+        }
+        if (!input) {
+            throw std::runtime_error("Unexpected end of file: " + fileName);
+        }
+    }
+    channels_ = std::move(channels);
+}
+
+std::vector<std::uint32_t> HotPixelDetector::getChannelIDs() const noexcept {
+    std::vector<std::uint32_t> ids;
+    for (const auto& channel : channels_) {
+        ids.emplace_back(channel.first);
+    }
+    return ids;
+}
+
+std::uint64_t HotPixelDetector::getFrameCount(
+    const std::uint32_t channelID
+) const noexcept {
+    auto channel = channels_.find(channelID);
+    if (channel == channels_.end()) {
+        return 0;
+    }
+    return channel->second.frames;
+}
+
+std::uint64_t HotPixelDetector::getHitCount(
+    const std::uint32_t channelID,
+    const std::uint32_t x,
+    const std::uint32_t y
+) const noexcept {
+    auto channel = channels_.find(channelID);
+    if (channel == channels_.end()) {
+        return 0;
+    }
+    return channel->second.hits[x * 256 + y];
+}
+
+double HotPixelDetector::getMeanCount(
+    const std::uint32_t channelID,
+    const std::uint32_t x,
+    const std::uint32_t y
+) const noexcept {
+    auto channel = channels_.find(channelID);
+    if (channel == channels_.end() || channel->second.hits[x * 256 + y] == 0) {
+        return 0.0;
+    }
+    const auto& stats = channel->second;
+    return static_cast<double>(stats.countSums[x * 256 + y]) /
+        stats.hits[x * 256 + y];
+}
+
+double HotPixelDetector::getCountStdDev(
+    const std::uint32_t channelID,
+    const std::uint32_t x,
+    const std::uint32_t y
+) const noexcept {
+    auto channel = channels_.find(channelID);
+    if (channel == channels_.end() || channel->second.hits[x * 256 + y] == 0) {
+        return 0.0;
+    }
+    const auto& stats = channel->second;
+    double n = stats.hits[x * 256 + y];
+    double mean = stats.countSums[x * 256 + y] / n;
+    double variance = stats.countSquareSums[x * 256 + y] / n - mean * mean;
+    return variance > 0 ? std::sqrt(variance) : 0.0;
+}
+
+PixelMask HotPixelDetector::getHotPixels(
+    const std::uint32_t channelID,
+    const HotPixelThresholds& thresholds
+) const noexcept {
+    PixelMask mask;
+    auto channel = channels_.find(channelID);
+    if (
+        channel == channels_.end() ||
+        channel->second.frames == 0 ||
+        channel->second.frames < thresholds.minFrames
+    ) {
+        return mask;
+    }
+
+    const auto& stats = channel->second;
+    for (std::uint32_t x = 0; x < 256; ++x) {
+        for (std::uint32_t y = 0; y < 256; ++y) {
+            auto hits = stats.hits[x * 256 + y];
+            if (hits == 0) {
+                continue;
+            }
+
+            bool isHot = static_cast<double>(hits) / stats.frames >
+                thresholds.maxHitFraction;
+            if (thresholds.maxMeanCount > 0) {
+                isHot = isHot ||
+                    getMeanCount(channelID, x, y) > thresholds.maxMeanCount;
+            }
+            if (
+                thresholds.minCountStdDev >= 0 &&
+                hits >= thresholds.minHitsForSpread
+            ) {
+                isHot = isHot ||
+                    getCountStdDev(channelID, x, y) <= thresholds.minCountStdDev;
+            }
+
+            if (isHot) {
+                mask.setMasked(x, y);
+            }
+        }
+    }
+
+    return mask;
+}
+
+} // lane
@@ -17,11 +17,18 @@
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <algorithm>
+#include <utility>
 #include <cstdint>
 #include "LaneFile.hpp"
+#include "LaneIndex.hpp"
+#include "LaneFormat.hpp"
+#include "DuplicateFrameFilter.hpp"
 #include "Frame.hpp"
 #include "Pixel.hpp"
 #include "Utils/Misc.hpp"
+#include "Utils/Filesystem.hpp"
+#include "Utils/ThreadPool.hpp"
 
 namespace {
 
@@ -38,6 +45,191 @@ std::vector<std::string>& split(
     return elems;
 }
 
+// Where a chunk of the file body starts and ends
+struct Chunk {
+    std::uint64_t begin;
+    std::uint64_t end;
+    // True if the chunk starts with a channel ID line rather than a frame
+    bool startsWithChannel;
+    // Set if the channel of the chunk's first frames is known up front
+    bool isChannelKnown;
+    std::uint32_t channelID;
+};
+
+// A run of frames from a single channel
+struct Segment {
+    bool isChannelKnown;
+    std::uint32_t channelID;
+    std::vector<lane::Frame> frames;
+};
+
+// Parses the frames of a single chunk of a LANE file
+std::vector<Segment> parseChunk(const std::string& fileName, const Chunk& chunk) {
+    std::ifstream input(
+        fileName,
+        std::ios::binary | std::ios::in
+    );
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+    input.seekg(chunk.begin);
+    
+    std::vector<Segment> segments;
+    if (!chunk.startsWithChannel) {
+        segments.push_back(Segment{ chunk.isChannelKnown, chunk.channelID, {} });
+    }
+    
+    std::string buffer = "";
+    std::uint64_t position = chunk.begin;
+    bool isExpectingChannel = chunk.startsWithChannel;
+    bool isInFrame = false;
+    lane::Frame currentFrame;
+    while (position < chunk.end && std::getline(input, buffer)) {
+        position += buffer.size() + 1;
+        if (isInFrame) {
+            // Get pixels
+            if (buffer == "EOF") {
+                segments.back().frames.emplace_back(std::move(currentFrame));
+                isInFrame = false;
+                continue;
+            }
+            std::uint32_t x, y, c;
+            lane::parseLanePixel(buffer.c_str(), x, y, c);
+            currentFrame.setPixel(x, y, c);
+        } else if (isExpectingChannel) {
+            // Get channel ID
+            if (buffer.empty()) {
+                continue;
+            }
+            std::uint32_t channelID;
+            lane::parseLaneNumber(buffer.c_str(), channelID, '\0');
+            segments.push_back(Segment{ true, channelID, {} });
+            isExpectingChannel = false;
+        } else if (buffer == "EOC") {
+            isExpectingChannel = true;
+        } else {
+            // Get frame timestamp
+            currentFrame = lane::Frame();
+            currentFrame.setChannelID(segments.back().channelID);
+            std::uint32_t timeStamp, timeStampSub;
+            auto p = lane::parseLaneNumber(buffer.c_str(), timeStamp, '.');
+            lane::parseLaneNumber(p, timeStampSub, '\0');
+            currentFrame.setTimeStamp(timeStamp);
+            currentFrame.setTimeStampSub(timeStampSub);
+            isInFrame = true;
+        }
+    }
+    
+    // Keep a final frame which is missing its end of frame marker
+    if (isInFrame) {
+        segments.back().frames.emplace_back(std::move(currentFrame));
+    }
+    
+    return segments;
+}
+
+// Finds the position just after the next end of frame marker line at or
+// after the given offset, or the end of the file if there isn't one
+std::uint64_t findNextFrameBoundary(
+    std::ifstream& input,
+    const std::uint64_t offset,
+    const std::uint64_t fileSize
+) {
+    const std::string marker = "\nEOF\n";
+    const std::size_t blockSize = 64 * 1024;
+    std::string block(blockSize + marker.size(), '\0');
+    
+    // Start a character early in case the offset lands on the marker itself
+    std::uint64_t position = offset - 1;
+    while (position < fileSize) {
+        input.clear();
+        input.seekg(position);
+        input.read(&block[0], block.size());
+        auto count = static_cast<std::size_t>(input.gcount());
+        auto found = block.find(marker);
+        if (found != std::string::npos && found + marker.size() <= count) {
+            return position + found + marker.size();
+        }
+        if (count < block.size()) {
+            break;
+        }
+        // Overlap the blocks so a marker split between them is still found
+        position += blockSize;
+    }
+    
+    return fileSize;
+}
+
+// Splits the file body into chunks, each starting on a frame boundary.
+// Uses the file's index if there's an up to date one, and scans for
+// boundaries otherwise
+std::vector<Chunk> findChunks(
+    const std::string& fileName,
+    const std::uint64_t bodyOffset,
+    const std::uint64_t fileSize,
+    const unsigned int threadCount
+) {
+    // Small files aren't worth splitting up
+    const std::uint64_t minChunkSize = 4 * 1024 * 1024;
+    std::vector<Chunk> chunks;
+    chunks.push_back(Chunk{ bodyOffset, fileSize, true, false, 0 });
+    if (threadCount <= 1 || fileSize - bodyOffset < 2 * minChunkSize) {
+        return chunks;
+    }
+    auto chunkCount = std::min<std::uint64_t>(
+        threadCount,
+        (fileSize - bodyOffset) / minChunkSize
+    );
+    
+    lane::LaneIndex index;
+    auto indexFileName = lane::LaneIndex::getIndexFileName(fileName);
+    if (lane::utils::fileExists(indexFileName)) {
+        try {
+            index.read(indexFileName);
+            if (!index.isValidFor(fileName)) {
+                index = lane::LaneIndex();
+            }
+        } catch (const std::runtime_error&) {
+            index = lane::LaneIndex();
+        }
+    }
+    
+    const auto& entries = index.getEntries();
+    if (!entries.empty()) {
+        // Split evenly by frame count, starting each chunk on a known frame
+        for (std::uint64_t i = 1; i < chunkCount; ++i) {
+            const auto& entry = entries[i * entries.size() / chunkCount];
+            if (entry.offset > chunks.back().begin) {
+                chunks.back().end = entry.offset;
+                chunks.push_back(Chunk{
+                    entry.offset, fileSize, false, true, entry.channelID
+                });
+            }
+        }
+        return chunks;
+    }
+    
+    // Split evenly by size, moving each split forward to a frame boundary
+    std::ifstream input(
+        fileName,
+        std::ios::binary | std::ios::in
+    );
+    for (std::uint64_t i = 1; i < chunkCount; ++i) {
+        auto target = bodyOffset + i * (fileSize - bodyOffset) / chunkCount;
+        if (target <= chunks.back().begin) {
+            continue;
+        }
+        auto boundary = findNextFrameBoundary(input, target, fileSize);
+        if (boundary >= fileSize) {
+            break;
+        }
+        chunks.back().end = boundary;
+        chunks.push_back(Chunk{ boundary, fileSize, false, false, 0 });
+    }
+    
+    return chunks;
+}
+
 }
 
 
@@ -45,10 +237,10 @@ namespace lane {
 
 LaneFile::LaneFile() = default;
 
-LaneFile::LaneFile(const std::string& fileName)
+LaneFile::LaneFile(const std::string& fileName, unsigned int threadCount)
 : startTime_(0),
 fileID_("") {
-    read(fileName);
+    read(fileName, threadCount);
 }
 
 LaneFile::~LaneFile() noexcept = default;
@@ -91,7 +283,7 @@ bool LaneFile::operator!=(const LaneFile& other) const noexcept {
 // EOC
 // CHANNELID 
 // ...etc
-void LaneFile::read(const std::string& fileName) {
+void LaneFile::read(const std::string& fileName, unsigned int threadCount) {
     clear();
     std::ifstream input(
         fileName,
@@ -111,44 +303,47 @@ void LaneFile::read(const std::string& fileName) {
     // Get the start time
     startTime_ = std::stoi(splitElems[1]);
     splitElems.clear();
+    input.close();
     
-    while (std::getline(input, buffer)) {
-        // Get channel ID
-        std::uint32_t currentChannelID = 0;
-        currentChannelID = std::stoi(buffer);
-        
-        // Get Frames for a channel
-        while (std::getline(input, buffer)) {
-            if (input.eof() || buffer == "EOC") {
-                break;
+    // Split the body into chunks which start on frame boundaries
+    std::uint64_t bodyOffset = buffer.size() + 1;
+    std::uint64_t fileSize = utils::getFileSize(fileName);
+    auto chunks = findChunks(fileName, bodyOffset, fileSize, threadCount);
+    
+    // Parse the chunks in parallel on the shared thread pool
+    std::vector<std::vector<Segment>> results(chunks.size());
+    utils::ThreadPool::getShared().parallelFor(
+        chunks.size(),
+        [&](const std::size_t i) {
+            results[i] = parseChunk(fileName, chunks[i]);
+        },
+        threadCount
+    );
+    
+    // Merge the chunks back together in file order. Chunks which started
+    // part way through a channel carry on the channel of the one before.
+    // Repeated frames are dropped on the way
+    DuplicateFrameFilter duplicates;
+    std::uint32_t currentChannelID = 0;
+    for (auto& segments : results) {
+        for (auto& segment : segments) {
+            if (segment.isChannelKnown) {
+                currentChannelID = segment.channelID;
             }
-            Frame currentFrame;
-            currentFrame.setChannelID(currentChannelID);
-            
-            // Get frame timestamp
-            split(buffer, '.', splitElems);
-            currentFrame.setTimeStamp(std::stoi(splitElems[0]));
-            currentFrame.setTimeStampSub(std::stoi(splitElems[1]));
-            splitElems.clear();
-
-            // Get pixels
-            while (std::getline(input, buffer)) {
-                if (input.eof() || buffer == "EOF") {
-                    break;
+            auto& frames = channels_[currentChannelID];
+            frames.reserve(frames.size() + segment.frames.size());
+            for (auto& frame : segment.frames) {
+                if (!segment.isChannelKnown) {
+                    frame.setChannelID(currentChannelID);
                 }
-                
-                split(buffer, ',', splitElems);
-                std::uint32_t x = std::stoi(splitElems[0]);
-                std::uint32_t y = std::stoi(splitElems[1]);
-                std::uint32_t c = std::stoi(splitElems[2]);
-                splitElems.clear();
-                
-                currentFrame.setPixel(x, y, c);
+                if (duplicates.isDuplicate(frame)) {
+                    continue;
+                }
+                frames.emplace_back(std::move(frame));
             }
-            
-            addFrame(currentFrame, currentChannelID);
         }
     }
+    duplicateCount_ = duplicates.getDuplicateCount();
 }
 
 void LaneFile::write(const std::string& fileName) {
@@ -191,7 +386,19 @@ void LaneFile::addFrame(
 std::vector<Frame> LaneFile::getFrames(
     const std::uint32_t channelID
 ) const noexcept {
-    return channels_.find(channelID)->second;
+    auto channel = channels_.find(channelID);
+    if (channel == channels_.end()) {
+        return std::vector<Frame>();
+    }
+    return channel->second;
+}
+
+std::vector<std::uint32_t> LaneFile::getChannelIDs() const {
+    std::vector<std::uint32_t> channelIDs;
+    for (const auto& channel : channels_) {
+        channelIDs.emplace_back(channel.first);
+    }
+    return channelIDs;
 }
 
 void LaneFile::setFileID(const std::string& fileID) noexcept {
@@ -210,8 +417,13 @@ std::uint32_t LaneFile::getStartTime() const noexcept {
     return startTime_;
 }
 
+std::uint64_t LaneFile::getDuplicateFrameCount() const noexcept {
+    return duplicateCount_;
+}
+
 void LaneFile::clear() noexcept {
     channels_.clear();
+    duplicateCount_ = 0;
 }
 
 std::ostream& operator<<(std::ostream& os, const LaneFile& file) noexcept {
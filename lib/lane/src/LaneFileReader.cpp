@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneFileReader.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Streams the frames of a channel from a LANE intermediate file
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <cstdint>
+#include "LaneFileReader.hpp"
+#include "LaneIndex.hpp"
+#include "LaneFormat.hpp"
+#include "DuplicateFrameFilter.hpp"
+#include "Frame.hpp"
+
+namespace lane {
+
+LaneFileReader::LaneFileReader(
+    const std::string& fileName,
+    const std::uint32_t channelID
+)
+: fileName_(fileName),
+  channelID_(channelID),
+  entries_(LaneIndex::load(fileName).getEntries(channelID)),
+  position_(0),
+  offset_(0),
+  duplicates_() {
+    open();
+}
+
+LaneFileReader::LaneFileReader(
+    const std::string& fileName,
+    const LaneIndex& index,
+    const std::uint32_t channelID
+)
+: fileName_(fileName),
+  channelID_(channelID),
+  entries_(index.getEntries(channelID)),
+  position_(0),
+  offset_(0),
+  duplicates_() {
+    open();
+}
+
+LaneFileReader::~LaneFileReader() = default;
+
+bool LaneFileReader::next(Frame& frame) {
+    while (readFrame(frame)) {
+        if (!duplicates_.isDuplicate(frame)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void LaneFileReader::rewind() noexcept {
+    position_ = 0;
+    duplicates_.clear();
+}
+
+void LaneFileReader::seek(const std::size_t frame) noexcept {
+    if (frame < position_) {
+        duplicates_.clear();
+    }
+    position_ = frame;
+}
+
+bool LaneFileReader::readAt(const std::size_t position, Frame& frame) {
+    position_ = position;
+    return readFrame(frame);
+}
+
+std::size_t LaneFileReader::getFrameCount() const noexcept {
+    return entries_.size();
+}
+
+std::uint64_t LaneFileReader::getDuplicateFrameCount() const noexcept {
+    return duplicates_.getDuplicateCount();
+}
+
+void LaneFileReader::open() {
+    input_.open(fileName_, std::ios::binary | std::ios::in);
+    if (!input_.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName_);
+    }
+}
+
+bool LaneFileReader::readFrame(Frame& frame) {
+    if (position_ >= entries_.size()) {
+        return false;
+    }
+    const auto& entry = entries_[position_++];
+    if (entry.offset != offset_) {
+        input_.clear();
+        input_.seekg(entry.offset);
+        offset_ = entry.offset;
+    }
+
+    frame = Frame();
+    frame.setChannelID(channelID_);
+    frame.setTimeStamp(entry.timeStamp);
+    frame.setTimeStampSub(entry.timeStampSub);
+
+    // Skip the time stamp line, which the index already has, and read the
+    // pixels up to the end of frame marker
+    std::string buffer = "";
+    std::getline(input_, buffer);
+    offset_ += buffer.size() + 1;
+    while (std::getline(input_, buffer)) {
+        offset_ += buffer.size() + 1;
+        if (buffer == "EOF") {
+            return true;
+        }
+        std::uint32_t x, y, c;
+        parseLanePixel(buffer.c_str(), x, y, c);
+        frame.setPixel(x, y, c);
+    }
+    // Keep a final frame which is missing its end of frame marker
+    return true;
+}
+
+} // lane
@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneFormat.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Parsing of the lines of LANE intermediate files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdint>
+#include "LaneFormat.hpp"
+
+namespace lane {
+
+const char* parseLaneNumber(
+    const char* s,
+    std::uint32_t& value,
+    const char terminator
+) {
+    char* end = nullptr;
+    value = std::strtoul(s, &end, 10);
+    if (end == s || *end != terminator) {
+        throw std::runtime_error("Malformed line in LANE file: " + std::string(s));
+    }
+    return terminator == '\0' ? end : end + 1;
+}
+
+void parseLanePixel(
+    const char* s,
+    std::uint32_t& x,
+    std::uint32_t& y,
+    std::uint32_t& c
+) {
+    auto p = parseLaneNumber(s, x, ',');
+    p = parseLaneNumber(p, y, ',');
+    parseLaneNumber(p, c, '\0');
+    if (x > 255 || y > 255) {
+        throw std::runtime_error("Pixel out of range in LANE file: " + std::string(s));
+    }
+}
+
+} // lane
@@ -0,0 +1,292 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneIndex.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A frame offset index for LANE intermediate files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include "LaneIndex.hpp"
+#include "LaneFormat.hpp"
+#include "Utils/Filesystem.hpp"
+#include "Utils/Hash.hpp"
+
+namespace {
+
+const char indexMagic[4] = { 'L', 'I', 'D', 'X' };
+const std::uint32_t indexVersion = 2;
+
+// How much of each end of a LANE file goes into its content hash. Rewriting
+// a capture changes its header or its last frames, so this catches files
+// replaced within the modification time's resolution without reading them
+// all the way through
+const std::size_t hashedEndSize = 4096;
+
+// Hashes the first and last few kilobytes of a file
+std::uint64_t hashEnds(
+    const std::string& fileName,
+    const std::uint64_t fileSize
+) noexcept {
+    char buffer[hashedEndSize];
+    lane::utils::Hash64 hash;
+    hash.update(
+        buffer,
+        lane::utils::readFileRange(fileName, 0, buffer, sizeof(buffer))
+    );
+    if (fileSize > hashedEndSize) {
+        hash.update(
+            buffer,
+            lane::utils::readFileRange(
+                fileName,
+                fileSize - hashedEndSize,
+                buffer,
+                sizeof(buffer)
+            )
+        );
+    }
+    return hash.getDigest();
+}
+
+}
+
+namespace lane {
+
+LaneIndex::LaneIndex() noexcept
+: fileSize_(0),
+  modificationTime_(0),
+  contentHash_(0) {
+}
+
+LaneIndex::LaneIndex(
+    std::vector<LaneIndexEntry> entries,
+    const std::string& laneFileName
+)
+: entries_(std::move(entries)),
+  fileSize_(0),
+  modificationTime_(0),
+  contentHash_(0) {
+    stamp(laneFileName);
+}
+
+LaneIndex::~LaneIndex() noexcept = default;
+
+LaneIndex::LaneIndex(const LaneIndex& other) = default;
+
+LaneIndex::LaneIndex(LaneIndex&& other) = default;
+
+LaneIndex& LaneIndex::operator=(const LaneIndex& other) = default;
+
+LaneIndex& LaneIndex::operator=(LaneIndex&& other) = default;
+
+void LaneIndex::build(const std::string& laneFileName) {
+    std::ifstream input(
+        laneFileName,
+        std::ios::binary | std::ios::in
+    );
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + laneFileName);
+    }
+
+    entries_.clear();
+    stamp(laneFileName);
+
+    // Skip the ID,STARTTIME header
+    std::string buffer = "";
+    std::getline(input, buffer);
+    std::uint64_t position = buffer.size() + 1;
+
+    // Walk the lines, only looking closer at the channel and time stamp lines
+    bool isExpectingChannel = true;
+    bool isInFrame = false;
+    std::uint32_t channelID = 0;
+    while (std::getline(input, buffer)) {
+        auto lineOffset = position;
+        position += buffer.size() + 1;
+        if (isInFrame) {
+            if (buffer == "EOF") {
+                isInFrame = false;
+            }
+        } else if (isExpectingChannel) {
+            if (!buffer.empty()) {
+                parseLaneNumber(buffer.c_str(), channelID, '\0');
+                isExpectingChannel = false;
+            }
+        } else if (buffer == "EOC") {
+            isExpectingChannel = true;
+        } else {
+            // Parsed as strictly as the readers do, so that a malformed
+            // file fails the same way however it's read
+            LaneIndexEntry entry;
+            entry.channelID = channelID;
+            auto p = parseLaneNumber(buffer.c_str(), entry.timeStamp, '.');
+            parseLaneNumber(p, entry.timeStampSub, '\0');
+            entry.offset = lineOffset;
+            entries_.emplace_back(entry);
+            isInFrame = true;
+        }
+    }
+}
+
+// Binary format, in native byte order:
+// 4 bytes - magic 'LIDX'
+// 4 bytes - version
+// 8 bytes - size of the indexed file
+// 8 bytes - modification time of the indexed file
+// 8 bytes - hash of the first and last few kilobytes of the indexed file
+// 8 bytes - number of entries
+// entries - channel ID, time stamp, sub second time stamp (4 bytes each)
+// and offset (8 bytes)
+void LaneIndex::read(const std::string& fileName) {
+    std::ifstream input(
+        fileName,
+        std::ios::binary | std::ios::in
+    );
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint64_t count = 0;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (
+        !input ||
+        std::memcmp(magic, indexMagic, sizeof(magic)) != 0 ||
+        version != indexVersion
+    ) {
+        throw std::runtime_error("Not a valid LANE index file: " + fileName);
+    }
+    input.read(reinterpret_cast<char*>(&fileSize_), sizeof(fileSize_));
+    input.read(reinterpret_cast<char*>(&modificationTime_), sizeof(modificationTime_));
+    input.read(reinterpret_cast<char*>(&contentHash_), sizeof(contentHash_));
+    input.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+    entries_.clear();
+    entries_.reserve(count);
+    for (std::uint64_t i = 0; i < count && input; ++i) {
+        LaneIndexEntry entry;
+        input.read(reinterpret_cast<char*>(&entry.channelID), sizeof(entry.channelID));
+        input.read(reinterpret_cast<char*>(&entry.timeStamp), sizeof(entry.timeStamp));
+        input.read(reinterpret_cast<char*>(&entry.timeStampSub), sizeof(entry.timeStampSub));
+        input.read(reinterpret_cast<char*>(&entry.offset), sizeof(entry.offset));
+        entries_.emplace_back(entry);
+    }
+    if (!input) {
+        throw std::runtime_error("Truncated LANE index file: " + fileName);
+    }
+}
+
+void LaneIndex::write(const std::string& fileName) const {
+    std::ofstream output(
+        fileName,
+        std::ios::trunc | std::ios::binary | std::ios::out
+    );
+    if (!output.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    std::uint64_t count = entries_.size();
+    output.write(indexMagic, sizeof(indexMagic));
+    output.write(reinterpret_cast<const char*>(&indexVersion), sizeof(indexVersion));
+    output.write(reinterpret_cast<const char*>(&fileSize_), sizeof(fileSize_));
+    output.write(reinterpret_cast<const char*>(&modificationTime_), sizeof(modificationTime_));
+    output.write(reinterpret_cast<const char*>(&contentHash_), sizeof(contentHash_));
+    output.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& entry : entries_) {
+        output.write(reinterpret_cast<const char*>(&entry.channelID), sizeof(entry.channelID));
+        output.write(reinterpret_cast<const char*>(&entry.timeStamp), sizeof(entry.timeStamp));
+        output.write(reinterpret_cast<const char*>(&entry.timeStampSub), sizeof(entry.timeStampSub));
+        output.write(reinterpret_cast<const char*>(&entry.offset), sizeof(entry.offset));
+    }
+}
+
+bool LaneIndex::isValidFor(const std::string& laneFileName) const noexcept {
+    // Checked cheapest first, so only matching files get their ends read
+    return utils::fileExists(laneFileName) &&
+        utils::getFileSize(laneFileName) == fileSize_ &&
+        utils::getModificationTime(laneFileName) == modificationTime_ &&
+        hashEnds(laneFileName, fileSize_) == contentHash_;
+}
+
+const std::vector<LaneIndexEntry>& LaneIndex::getEntries() const noexcept {
+    return entries_;
+}
+
+std::vector<LaneIndexEntry> LaneIndex::getEntries(
+    const std::uint32_t channelID
+) const {
+    std::vector<LaneIndexEntry> channelEntries;
+    for (const auto& entry : entries_) {
+        if (entry.channelID == channelID) {
+            channelEntries.emplace_back(entry);
+        }
+    }
+    return channelEntries;
+}
+
+std::vector<std::uint32_t> LaneIndex::getChannelIDs() const {
+    std::vector<std::uint32_t> channelIDs;
+    for (const auto& entry : entries_) {
+        if (
+            std::find(channelIDs.begin(), channelIDs.end(), entry.channelID) ==
+            channelIDs.end()
+        ) {
+            channelIDs.emplace_back(entry.channelID);
+        }
+    }
+    std::sort(channelIDs.begin(), channelIDs.end());
+    return channelIDs;
+}
+
+std::uint64_t LaneIndex::getFileSize() const noexcept {
+    return fileSize_;
+}
+
+void LaneIndex::stamp(const std::string& laneFileName) {
+    fileSize_ = utils::getFileSize(laneFileName);
+    modificationTime_ = utils::getModificationTime(laneFileName);
+    contentHash_ = hashEnds(laneFileName, fileSize_);
+}
+
+std::string LaneIndex::getIndexFileName(const std::string& laneFileName) {
+    return laneFileName + ".lidx";
+}
+
+LaneIndex LaneIndex::load(const std::string& laneFileName) {
+    LaneIndex index;
+    auto indexFileName = getIndexFileName(laneFileName);
+    if (utils::fileExists(indexFileName)) {
+        try {
+            index.read(indexFileName);
+            if (index.isValidFor(laneFileName)) {
+                return index;
+            }
+        } catch (const std::runtime_error&) {
+            // Fall through and rebuild a broken index
+        }
+    }
+
+    index.build(laneFileName);
+    try {
+        index.write(indexFileName);
+    } catch (const std::runtime_error&) {
+        // The index is only a cache, so a read-only location is fine
+    }
+    return index;
+}
+
+} // lane
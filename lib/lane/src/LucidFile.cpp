@@ -0,0 +1,292 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LucidFile.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Reads LUCID raw data files straight into frames
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <map>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include "Utils/Endian.hpp"
+#include "Utils/Filesystem.hpp"
+#include "Frame.hpp"
+#include "Pixel.hpp"
+#include "RleDecode.hpp"
+#include "LucidHeader.hpp"
+#include "DuplicateFrameFilter.hpp"
+#include "LucidFile.hpp"
+
+namespace lane {
+
+namespace {
+
+// Frame marker (2 bytes), time stamp (4 bytes) and sub-second time (1 byte)
+const std::size_t frameHeaderSize = 7;
+
+// Data words are decoded this many at a time while looking for the end of a
+// channel's data
+const std::size_t wordBlockSize = 1024;
+
+bool isFrameMarker(
+    const std::vector<unsigned char>& data,
+    const std::size_t position
+) noexcept {
+    return position + 1 < data.size() &&
+        data[position] == 0xDC && data[position + 1] == 0xDF;
+}
+
+// Gets the channel from the bit field of a channel marker, lowest bit first,
+// with 5 standing for none as in the intermediate file converter
+std::uint32_t getMarkerChannel(const unsigned char marker) noexcept {
+    for (std::uint32_t channel = 0; channel < 5; ++channel) {
+        if ((marker >> channel) & 0x01) {
+            return channel;
+        }
+    }
+    return 5;
+}
+
+}
+
+LucidFile::LucidFile() = default;
+
+LucidFile::LucidFile(const std::string& fileName) {
+    read(fileName);
+}
+
+LucidFile::~LucidFile() noexcept = default;
+
+LucidFile::LucidFile(const LucidFile& other) = default;
+
+LucidFile::LucidFile(LucidFile&& other) = default;
+
+LucidFile& LucidFile::operator=(const LucidFile& other) = default;
+
+LucidFile& LucidFile::operator=(LucidFile&& other) = default;
+
+void LucidFile::read(const std::string& fileName) {
+    DuplicateFrameFilter duplicates;
+    read(fileName, duplicates);
+}
+
+void LucidFile::read(
+    const std::string& fileName,
+    DuplicateFrameFilter& duplicates
+) {
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+    std::vector<unsigned char> data(utils::getFileSize(fileName));
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+    data.resize(static_cast<std::size_t>(file.gcount()));
+    decode(data, fileName, duplicates, true);
+}
+
+std::size_t LucidFile::decode(
+    const std::vector<unsigned char>& data,
+    DuplicateFrameFilter& duplicates,
+    const bool isFinal
+) {
+    return decode(data, "LUCID data", duplicates, isFinal);
+}
+
+// Frame Format:
+// 2 bytes - frame marker, 0xDC 0xDF
+// 4 bytes - time stamp, big endian
+// 1 byte - sub-second time
+// then for each channel until the next frame marker:
+// 1 byte - channel marker, top two bits set and the channel as a bit field
+// the channel's data words, up to the next control word
+std::size_t LucidFile::decode(
+    const std::vector<unsigned char>& data,
+    const std::string& source,
+    DuplicateFrameFilter& duplicates,
+    const bool isFinal
+) {
+    clear();
+    const auto previousDuplicates = duplicates.getDuplicateCount();
+    const auto size = data.size();
+
+    std::size_t position = 0;
+    if (size >= lucidHeaderSize) {
+        header_ = parseLucidHeader(data.data());
+    }
+    if (header_.isValid) {
+        if (header_.compression == LucidCompression::XYV) {
+            throw std::runtime_error(
+                "XYV compressed LUCID data isn't supported: " + source
+            );
+        }
+        position = lucidHeaderSize;
+    } else {
+        // Files carrying on a capture can start part way through a frame
+        header_.fileID = "????";
+        while (position < size && !isFrameMarker(data, position)) {
+            ++position;
+        }
+    }
+
+    // The data of each channel of a frame, as a range of the frame's words
+    struct ChannelData {
+        std::uint32_t channel;
+        std::size_t begin;
+        std::size_t count;
+    };
+    std::vector<ChannelData> channels;
+    std::vector<std::uint16_t> words;
+    std::vector<utils::WordType> types;
+    std::vector<Pixel> hits;
+    while (position + frameHeaderSize <= size) {
+        if (!isFrameMarker(data, position)) {
+            throw std::runtime_error(
+                "Expected frame header in " + source + ", position = " +
+                std::to_string(position)
+            );
+        }
+        const auto timeStamp = (static_cast<std::uint32_t>(data[position + 2]) << 24) |
+            (static_cast<std::uint32_t>(data[position + 3]) << 16) |
+            (static_cast<std::uint32_t>(data[position + 4]) << 8) |
+            static_cast<std::uint32_t>(data[position + 5]);
+        const auto timeStampSub = static_cast<std::uint32_t>(data[position + 6]);
+        const auto start = position;
+        position += frameHeaderSize;
+
+        // The data of every channel is found before any is decoded, so that
+        // a frame cut short by the end of data which isn't final can be left
+        // for next time
+        channels.clear();
+        std::size_t total = 0;
+        // A lone byte left at the end of the file is ignored
+        while (position + 1 < size && !isFrameMarker(data, position)) {
+            const auto marker = data[position];
+            if ((marker >> 6) != 0x03) {
+                throw std::runtime_error(
+                    "Expected channel control word in " + source +
+                    ", position = " + std::to_string(position)
+                );
+            }
+            const auto channel = getMarkerChannel(marker);
+            ++position;
+
+            // The channel's data runs up to the next control word, or the
+            // end of the file. Words are decoded a block at a time, and only
+            // blocks with a control word in need searching
+            std::size_t count = 0;
+            for (;;) {
+                const auto available = (size - position) / 2 - count;
+                if (available == 0) {
+                    break;
+                }
+                const auto n = std::min(available, wordBlockSize);
+                if (words.size() < total + count + n) {
+                    words.resize(total + count + n);
+                    types.resize(total + count + n);
+                }
+                const auto controls = utils::decodeBigEndianWords(
+                    &data[position + count * 2],
+                    &words[total + count],
+                    &types[total + count],
+                    n
+                );
+                if (controls != 0) {
+                    count = std::find(
+                        types.begin() + total + count,
+                        types.begin() + total + count + n,
+                        utils::WordType::Control
+                    ) - (types.begin() + total);
+                    break;
+                }
+                count += n;
+            }
+            channels.push_back(ChannelData{ channel, total, count });
+            total += count;
+            position += count * 2;
+        }
+        if (position + 1 >= size) {
+            if (!isFinal) {
+                return start;
+            }
+            position = size;
+        }
+
+        // The frame is dropped as a whole if every channel is a repeat
+        bool isDuplicate = !channels.empty();
+        for (const auto& c : channels) {
+            hits.clear();
+            decodeRleSparse(&words[c.begin], &types[c.begin], c.count, hits);
+            Frame frame;
+            frame.setChannelID(c.channel);
+            frame.setTimeStamp(timeStamp);
+            frame.setTimeStampSub(timeStampSub);
+            for (const auto& p : hits) {
+                frame.setPixel(p.getX(), p.getY(), p.getC());
+            }
+            if (!duplicates.isDuplicate(frame)) {
+                isDuplicate = false;
+                channels_[c.channel].emplace_back(std::move(frame));
+            }
+        }
+        records_.push_back(LucidFrameRecord{ start, position - start, isDuplicate });
+        duplicateCount_ = duplicates.getDuplicateCount() - previousDuplicates;
+    }
+    return position;
+}
+
+std::vector<Frame> LucidFile::getFrames(
+    const std::uint32_t channelID
+) const noexcept {
+    auto found = channels_.find(channelID);
+    if (found == channels_.end()) {
+        return std::vector<Frame>();
+    }
+    return found->second;
+}
+
+std::map<std::uint32_t, std::vector<Frame>> LucidFile::getChannelToFramesMap(
+) const noexcept {
+    return channels_;
+}
+
+std::uint32_t LucidFile::getStartTime() const noexcept {
+    return header_.startTime;
+}
+
+std::string LucidFile::getFileID() const noexcept {
+    return header_.fileID;
+}
+
+const LucidHeader& LucidFile::getHeader() const noexcept {
+    return header_;
+}
+
+std::uint64_t LucidFile::getDuplicateFrameCount() const noexcept {
+    return duplicateCount_;
+}
+
+const std::vector<LucidFrameRecord>& LucidFile::getFrameRecords(
+) const noexcept {
+    return records_;
+}
+
+void LucidFile::clear() noexcept {
+    header_ = LucidHeader();
+    channels_.clear();
+    duplicateCount_ = 0;
+    records_.clear();
+}
+
+} // lane
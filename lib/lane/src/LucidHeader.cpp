@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LucidHeader.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Reading of LUCID raw data file headers, and grouping of raw data
+/// files into captures
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include "Utils/Filesystem.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "LucidHeader.hpp"
+
+namespace lane {
+
+// Header Format:
+// 2 bytes - header magic, 0xDC 0xCC
+// 1 byte - matrix table bits [1:0] and a bit field of the active chips
+// 1 byte - matrix table bits [9:2]
+// 2 bytes - shutter mode
+// 1 byte - compression bit field
+// 1 byte - shutter rate
+// 4 bytes - start time, big endian
+// 4 bytes - file ID, stored back to front
+LucidHeader parseLucidHeader(const unsigned char* bytes) {
+    LucidHeader header;
+    if (bytes[0] != 0xDC || bytes[1] != 0xCC) {
+        return header;
+    }
+    header.isValid = true;
+    header.activeChips = bytes[2] & 0x1F;
+    header.matrixTable = static_cast<std::uint16_t>(
+        (bytes[3] << 2) | (bytes[2] >> 6)
+    );
+    header.shutterMode = static_cast<std::uint16_t>((bytes[4] << 8) | bytes[5]);
+    // Bit 0 - compression on, bit 1 - linear LUT, bit 2 - RLE (0) or XYV (1)
+    if (bytes[6] & 0x01) {
+        header.compression = (bytes[6] & 0x04) ?
+            LucidCompression::XYV :
+            LucidCompression::RLE;
+    }
+    header.isLinearLUT = (bytes[6] & 0x02) != 0;
+    header.shutterRate = bytes[7];
+    header.startTime = (static_cast<std::uint32_t>(bytes[8]) << 24) |
+        (static_cast<std::uint32_t>(bytes[9]) << 16) |
+        (static_cast<std::uint32_t>(bytes[10]) << 8) |
+        static_cast<std::uint32_t>(bytes[11]);
+    for (int i = 15; i >= 12; --i) {
+        header.fileID += static_cast<char>(bytes[i]);
+    }
+    return header;
+}
+
+LucidHeader readLucidHeader(const std::string& fileName) {
+    unsigned char bytes[lucidHeaderSize];
+    if (utils::readFileRange(fileName, 0, bytes, sizeof(bytes)) != sizeof(bytes)) {
+        return LucidHeader();
+    }
+    return parseLucidHeader(bytes);
+}
+
+std::vector<LucidFileInfo> scanLucidHeaders(
+    const std::vector<utils::FileInfo>& files,
+    unsigned int threads
+) {
+    std::vector<LucidFileInfo> result(files.size());
+    // The threads of the shared pool take the next file to read until there
+    // are none left
+    utils::ThreadPool::getShared().parallelFor(
+        files.size(),
+        [&](const std::size_t i) {
+            result[i].file = files[i];
+            result[i].header = readLucidHeader(files[i].path);
+        },
+        threads
+    );
+    return result;
+}
+
+std::string getLucidFileTimeStamp(const std::string& path) {
+    const auto name = utils::removeExtension(utils::getFileName(path));
+    // The 4th and 5th underscore separated parts
+    std::vector<std::string> parts;
+    std::string::size_type start = 0;
+    while (parts.size() < 6) {
+        auto end = name.find('_', start);
+        parts.emplace_back(name.substr(start, end - start));
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    if (parts.size() < 5) {
+        return name;
+    }
+    return parts[3] + "_" + parts[4];
+}
+
+std::vector<LucidCapture> groupLucidCaptures(std::vector<LucidFileInfo> files) {
+    // Work out the sort keys once, rather than in every comparison
+    std::vector<std::pair<std::string, std::size_t>> order;
+    order.reserve(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        order.emplace_back(getLucidFileTimeStamp(files[i].file.path), i);
+    }
+    std::sort(
+        order.begin(),
+        order.end(),
+        [&](const std::pair<std::string, std::size_t>& lhs,
+            const std::pair<std::string, std::size_t>& rhs) {
+            return lhs.first < rhs.first || (lhs.first == rhs.first &&
+                files[lhs.second].file.path < files[rhs.second].file.path);
+        }
+    );
+
+    std::vector<LucidCapture> captures;
+    for (const auto& entry : order) {
+        auto& file = files[entry.second];
+        if (file.header.isValid || captures.empty()) {
+            captures.emplace_back();
+            captures.back().header = file.header;
+        }
+        captures.back().files.emplace_back(std::move(file.file));
+    }
+
+    std::stable_sort(
+        captures.begin(),
+        captures.end(),
+        [](const LucidCapture& lhs, const LucidCapture& rhs) {
+            return lhs.header.startTime < rhs.header.startTime ||
+                (lhs.header.startTime == rhs.header.startTime &&
+                    lhs.header.fileID < rhs.header.fileID);
+        }
+    );
+    return captures;
+}
+
+} // lane
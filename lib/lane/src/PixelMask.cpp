@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file PixelMask.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Pixel mask storage class
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include "Frame.hpp"
+#include "PixelMask.hpp"
+
+namespace lane {
+
+PixelMask::PixelMask() noexcept = default;
+
+PixelMask::PixelMask(const std::string& fileName) {
+    read(fileName);
+}
+
+PixelMask::~PixelMask() noexcept = default;
+
+PixelMask::PixelMask(const PixelMask& other) = default;
+
+PixelMask::PixelMask(PixelMask&& other) = default;
+
+PixelMask& PixelMask::operator=(const PixelMask& other) = default;
+
+PixelMask& PixelMask::operator=(PixelMask&& other) = default;
+
+bool PixelMask::operator==(const PixelMask& other) const noexcept {
+    return masked_ == other.masked_;
+}
+
+bool PixelMask::operator!=(const PixelMask& other) const noexcept {
+    return !(*this == other);
+}
+
+// Currently in the following format:
+// # COMMENT
+// X,Y
+// ...etc
+void PixelMask::read(const std::string& fileName) {
+    std::ifstream input(fileName, std::ios::in);
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    masked_.reset();
+    std::string buffer = "";
+    while (std::getline(input, buffer)) {
+        if (buffer.empty() || buffer[0] == '#') {
+            continue;
+        }
+        auto separator = buffer.find(',');
+        if (separator == std::string::npos) {
+            throw std::runtime_error("Malformed mask file: " + fileName);
+        }
+        std::uint32_t x = std::stoi(buffer.substr(0, separator));
+        std::uint32_t y = std::stoi(buffer.substr(separator + 1));
+        if (x > 255 || y > 255) {
+            throw std::runtime_error("Pixel out of range in mask file: " + fileName);
+        }
+        setMasked(x, y);
+    }
+}
+
+void PixelMask::write(const std::string& fileName) const {
+    std::ofstream output(
+        fileName,
+        std::ios::trunc | std::ios::binary | std::ios::out
+    );
+    if (!output.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    output << "# Masked pixels: " << getMaskedCount() << "\n";
+    for (std::uint32_t x = 0; x < 256; ++x) {
+        for (std::uint32_t y = 0; y < 256; ++y) {
+            if (isMasked(x, y)) {
+                output << x << "," << y << "\n";
+            }
+        }
+    }
+}
+
+void PixelMask::setMasked(
+    const std::uint32_t x,
+    const std::uint32_t y,
+    const bool isMasked
+) noexcept {
+    masked_[x * 256 + y] = isMasked;
+}
+
+bool PixelMask::isMasked(
+    const std::uint32_t x,
+    const std::uint32_t y
+) const noexcept {
+    return masked_[x * 256 + y];
+}
+
+std::size_t PixelMask::getMaskedCount() const noexcept {
+    return masked_.count();
+}
+
+void PixelMask::merge(const PixelMask& other) noexcept {
+    masked_ |= other.masked_;
+}
+
+std::size_t PixelMask::apply(const Frame& frame, Frame& masked) const {
+    masked = Frame();
+    masked.setChannelID(frame.getChannelID());
+    masked.setTimeStamp(frame.getTimeStamp());
+    masked.setTimeStampSub(frame.getTimeStampSub());
+    std::size_t dropped = 0;
+    for (const auto& p : frame.getPixels()) {
+        const auto x = p.second.getX();
+        const auto y = p.second.getY();
+        if (isMasked(x, y)) {
+            ++dropped;
+        } else {
+            masked.setPixel(x, y, p.second.getC());
+        }
+    }
+    return dropped;
+}
+
+} // lane
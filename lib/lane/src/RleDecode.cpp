@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file RleDecode.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Decoding of run length encoded LUCID frame data
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "RleDecode.hpp"
+
+namespace lane {
+
+namespace {
+
+// The count is in the low 14 bits of a payload word, and the run length in
+// the low 15 bits of a zero run word
+constexpr std::uint16_t payloadMask = 0x3FFF;
+constexpr std::uint16_t runMask = 0x7FFF;
+
+}
+
+std::size_t decodeRleDense(
+    const std::uint16_t* words,
+    const utils::WordType* types,
+    const std::size_t count,
+    std::uint16_t* image
+) noexcept {
+    std::size_t i = 0;
+    std::uint32_t position = 0;
+    while (i < count && types[i] != utils::WordType::Control) {
+        if (types[i] == utils::WordType::ZeroRun) {
+            const std::uint32_t run = std::min<std::uint32_t>(
+                words[i] & runMask,
+                framePixelCount - position
+            );
+            std::memset(image + position, 0, run * sizeof(*image));
+            position += run;
+            ++i;
+            continue;
+        }
+
+        // Copy the whole stretch of payload words in one loop
+        std::size_t end = i + 1;
+        while (end < count && types[end] == utils::WordType::Payload) {
+            ++end;
+        }
+        const auto length = static_cast<std::uint32_t>(
+            std::min<std::size_t>(end - i, framePixelCount - position)
+        );
+        const std::uint16_t* payload = words + i;
+        std::uint16_t* out = image + position;
+        for (std::uint32_t j = 0; j < length; ++j) {
+            out[j] = payload[j] & payloadMask;
+        }
+        position += length;
+        i = end;
+    }
+    std::memset(image + position, 0, (framePixelCount - position) * sizeof(*image));
+    return i;
+}
+
+std::size_t decodeRleSparse(
+    const std::uint16_t* words,
+    const utils::WordType* types,
+    const std::size_t count,
+    std::vector<Pixel>& hits
+) {
+    std::size_t i = 0;
+    std::size_t position = 0;
+    for (; i < count; ++i) {
+        const auto type = types[i];
+        if (type == utils::WordType::ZeroRun) {
+            position += words[i] & runMask;
+        } else if (type == utils::WordType::Payload) {
+            const std::uint16_t c = words[i] & payloadMask;
+            if (c != 0 && position < framePixelCount) {
+                const auto p = static_cast<std::uint32_t>(position);
+                hits.emplace_back(p % frameWidth, p / frameWidth, c);
+            }
+            ++position;
+        } else {
+            break;
+        }
+    }
+    return i;
+}
+
+} // lane
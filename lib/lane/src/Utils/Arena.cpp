@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Arena.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A monotonic arena allocator and an STL compatible allocator adaptor
+/// for it
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include "Utils/Arena.hpp"
+
+namespace lane {
+namespace utils {
+
+Arena::Arena(const std::size_t blockSize)
+: currentBlock_(0),
+  offset_(0),
+  blockSize_(blockSize),
+  bytesUsed_(0) {
+}
+
+Arena::~Arena() noexcept {
+    release();
+}
+
+Arena::Arena(Arena&& other) noexcept
+: blocks_(std::move(other.blocks_)),
+  currentBlock_(other.currentBlock_),
+  offset_(other.offset_),
+  blockSize_(other.blockSize_),
+  bytesUsed_(other.bytesUsed_) {
+    other.blocks_.clear();
+    other.reset();
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(blocks_, other.blocks_);
+        currentBlock_ = other.currentBlock_;
+        offset_ = other.offset_;
+        blockSize_ = other.blockSize_;
+        bytesUsed_ = other.bytesUsed_;
+        other.reset();
+    }
+
+    return *this;
+}
+
+void* Arena::allocate(const std::size_t size, const std::size_t alignment) {
+    // Try the current block and then any blocks kept from before a reset
+    while (currentBlock_ < blocks_.size()) {
+        auto& block = blocks_[currentBlock_];
+        auto address = reinterpret_cast<std::uintptr_t>(block.data) + offset_;
+        auto padding = (alignment - (address % alignment)) % alignment;
+        if (offset_ + padding + size <= block.size) {
+            offset_ += padding + size;
+            bytesUsed_ += size;
+            return block.data + offset_ - size;
+        }
+        ++currentBlock_;
+        offset_ = 0;
+    }
+
+    // Out of blocks, so grab a new one big enough for the request.
+    // ::operator new returns memory aligned for any fundamental type
+    auto blockSize = size + alignment > blockSize_ ? size + alignment : blockSize_;
+    Block block = { static_cast<char*>(::operator new(blockSize)), blockSize };
+    blocks_.emplace_back(block);
+    currentBlock_ = blocks_.size() - 1;
+    offset_ = size;
+    bytesUsed_ += size;
+    return block.data;
+}
+
+void Arena::reset() noexcept {
+    currentBlock_ = 0;
+    offset_ = 0;
+    bytesUsed_ = 0;
+}
+
+void Arena::release() noexcept {
+    for (auto& block : blocks_) {
+        ::operator delete(block.data);
+    }
+    blocks_.clear();
+    reset();
+}
+
+std::size_t Arena::getBytesUsed() const noexcept {
+    return bytesUsed_;
+}
+
+std::size_t Arena::getCapacity() const noexcept {
+    std::size_t capacity = 0;
+    for (const auto& block : blocks_) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+} // utils
+} // lane
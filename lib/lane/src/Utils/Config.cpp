@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Config.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A simple INI style configuration file reader
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved. 
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cctype>
+#include "Utils/Config.hpp"
+
+namespace {
+
+// Removes the leading and trailing whitespace of a string
+std::string trim(const std::string& s) {
+    auto first = s.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return "";
+    }
+    auto last = s.find_last_not_of(" \t\r\n");
+    return s.substr(first, last - first + 1);
+}
+
+}
+
+namespace lane {
+namespace utils {
+
+Config::Config() = default;
+
+Config::Config(const std::string& fileName) {
+    read(fileName);
+}
+
+Config::~Config() noexcept = default;
+
+Config::Config(const Config& other) = default;
+
+Config::Config(Config&& other) = default;
+
+Config& Config::operator=(const Config& other) = default;
+
+Config& Config::operator=(Config&& other) = default;
+
+void Config::read(const std::string& fileName) {
+    std::ifstream input(fileName, std::ios::in);
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    std::string buffer = "";
+    std::string section = "";
+    unsigned int lineNumber = 0;
+    while (std::getline(input, buffer)) {
+        ++lineNumber;
+        auto line = trim(buffer);
+        // Skip blank lines and comments
+        if (line.empty() || line[0] == '#' || line[0] == ';') {
+            continue;
+        }
+
+        if (line[0] == '[') {
+            auto end = line.find(']');
+            if (end == std::string::npos) {
+                throw std::runtime_error(
+                    "Malformed section in " + fileName + " on line " +
+                    std::to_string(lineNumber)
+                );
+            }
+            section = trim(line.substr(1, end - 1));
+            continue;
+        }
+
+        auto separator = line.find_first_of(":=");
+        if (separator == std::string::npos) {
+            throw std::runtime_error(
+                "Expected 'key: value' in " + fileName + " on line " +
+                std::to_string(lineNumber)
+            );
+        }
+        sections_[section][trim(line.substr(0, separator))] =
+            trim(line.substr(separator + 1));
+    }
+}
+
+bool Config::hasValue(
+    const std::string& section,
+    const std::string& key
+) const noexcept {
+    auto s = sections_.find(section);
+    return s != sections_.end() && s->second.find(key) != s->second.end();
+}
+
+void Config::setValue(
+    const std::string& section,
+    const std::string& key,
+    const std::string& value
+) {
+    sections_[section][key] = value;
+}
+
+std::string Config::getString(
+    const std::string& section,
+    const std::string& key,
+    const std::string& defaultValue
+) const {
+    auto s = sections_.find(section);
+    if (s == sections_.end()) {
+        return defaultValue;
+    }
+    auto k = s->second.find(key);
+    if (k == s->second.end()) {
+        return defaultValue;
+    }
+    return k->second;
+}
+
+double Config::getDouble(
+    const std::string& section,
+    const std::string& key,
+    const double defaultValue
+) const {
+    if (!hasValue(section, key)) {
+        return defaultValue;
+    }
+    return std::stod(getString(section, key));
+}
+
+long long Config::getInteger(
+    const std::string& section,
+    const std::string& key,
+    const long long defaultValue
+) const {
+    if (!hasValue(section, key)) {
+        return defaultValue;
+    }
+    return std::stoll(getString(section, key));
+}
+
+bool Config::getBool(
+    const std::string& section,
+    const std::string& key,
+    const bool defaultValue
+) const {
+    if (!hasValue(section, key)) {
+        return defaultValue;
+    }
+    auto value = getString(section, key);
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+    if (value == "true" || value == "yes" || value == "on" || value == "1") {
+        return true;
+    }
+    if (value == "false" || value == "no" || value == "off" || value == "0") {
+        return false;
+    }
+    throw std::runtime_error(
+        "Expected a boolean for '" + key + "' in [" + section + "]"
+    );
+}
+
+std::vector<std::string> Config::getList(
+    const std::string& section,
+    const std::string& key
+) const {
+    std::vector<std::string> elems;
+    std::stringstream ss(getString(section, key));
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) {
+            elems.push_back(item);
+        }
+    }
+    return elems;
+}
+
+} // utils
+} // lane
@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Endian.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Bulk endian swapping and LUCID word decoding
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "Utils/Endian.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LANE_ENDIAN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// AVX2 is used when the compiler targets it, or picked at run time where the
+// compiler can build code for it without targeting it (gcc and clang)
+#if defined(__AVX2__)
+#define LANE_ENDIAN_AVX2 1
+#define LANE_ENDIAN_AVX2_TARGET
+#include <immintrin.h>
+#elif defined(LANE_ENDIAN_SSE2) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define LANE_ENDIAN_AVX2 1
+#define LANE_ENDIAN_AVX2_DISPATCH 1
+#define LANE_ENDIAN_AVX2_TARGET __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace lane {
+namespace utils {
+
+namespace {
+
+// Loads a big endian word from memory which may not be aligned
+inline std::uint16_t loadBigEndian(const unsigned char* bytes) noexcept {
+    return static_cast<std::uint16_t>((bytes[0] << 8) | bytes[1]);
+}
+
+void swapScalar(
+    const std::uint16_t* input,
+    std::uint16_t* output,
+    const std::size_t count
+) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        output[i] = swapEndian(input[i]);
+    }
+}
+
+std::size_t decodeScalar(
+    const unsigned char* input,
+    std::uint16_t* words,
+    WordType* types,
+    const std::size_t count
+) noexcept {
+    std::size_t controls = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint16_t word;
+        if (isBigEndian()) {
+            std::memcpy(&word, input + 2 * i, sizeof(word));
+        } else {
+            word = loadBigEndian(input + 2 * i);
+        }
+        words[i] = word;
+        types[i] = getWordType(word);
+        controls += types[i] == WordType::Control;
+    }
+    return controls;
+}
+
+inline unsigned int countBits(unsigned int bits) noexcept {
+#if defined(__GNUC__)
+    return static_cast<unsigned int>(__builtin_popcount(bits));
+#else
+    unsigned int count = 0;
+    for (; bits != 0; bits &= bits - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+#ifdef LANE_ENDIAN_SSE2
+
+inline __m128i swap128(const __m128i v) noexcept {
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+// The type of each word is its top two bits, with both types starting with
+// a zero bit mapped to ZeroRun
+inline __m128i types128(const __m128i v) noexcept {
+    return _mm_and_si128(_mm_srli_epi16(v, 14), _mm_srai_epi16(v, 15));
+}
+
+std::size_t swapSse2(
+    const std::uint16_t* input,
+    std::uint16_t* output,
+    const std::size_t count
+) noexcept {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(input + i)
+        );
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), swap128(v));
+    }
+    return i;
+}
+
+std::size_t decodeSse2(
+    const unsigned char* input,
+    std::uint16_t* words,
+    WordType* types,
+    const std::size_t count,
+    std::size_t& controls
+) noexcept {
+    const __m128i control = _mm_set1_epi8(3);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i lo = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(input + 2 * i)
+        );
+        __m128i hi = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(input + 2 * i + 16)
+        );
+        if (!isBigEndian()) {
+            lo = swap128(lo);
+            hi = swap128(hi);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i + 8), hi);
+        const __m128i t = _mm_packus_epi16(types128(lo), types128(hi));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(types + i), t);
+        controls += countBits(static_cast<unsigned int>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(t, control))
+        ));
+    }
+    return i;
+}
+
+#endif // LANE_ENDIAN_SSE2
+
+#ifdef LANE_ENDIAN_AVX2
+
+LANE_ENDIAN_AVX2_TARGET
+inline __m256i swap256(const __m256i v) noexcept {
+    return _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+}
+
+LANE_ENDIAN_AVX2_TARGET
+inline __m256i types256(const __m256i v) noexcept {
+    return _mm256_and_si256(_mm256_srli_epi16(v, 14), _mm256_srai_epi16(v, 15));
+}
+
+LANE_ENDIAN_AVX2_TARGET
+std::size_t swapAvx2(
+    const std::uint16_t* input,
+    std::uint16_t* output,
+    const std::size_t count
+) noexcept {
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(input + i)
+        );
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(output + i),
+            swap256(v)
+        );
+    }
+    return i;
+}
+
+LANE_ENDIAN_AVX2_TARGET
+std::size_t decodeAvx2(
+    const unsigned char* input,
+    std::uint16_t* words,
+    WordType* types,
+    const std::size_t count,
+    std::size_t& controls
+) noexcept {
+    const __m256i control = _mm256_set1_epi8(3);
+    std::size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i lo = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(input + 2 * i)
+        );
+        __m256i hi = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(input + 2 * i + 32)
+        );
+        if (!isBigEndian()) {
+            lo = swap256(lo);
+            hi = swap256(hi);
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words + i), lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words + i + 16), hi);
+        // Packing works within each 128-bit lane, so put the quarters back
+        // in order afterwards
+        const __m256i t = _mm256_permute4x64_epi64(
+            _mm256_packus_epi16(types256(lo), types256(hi)),
+            0xD8
+        );
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(types + i), t);
+        controls += countBits(static_cast<unsigned int>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(t, control))
+        ));
+    }
+    return i;
+}
+
+#endif // LANE_ENDIAN_AVX2
+
+inline bool hasAvx2() noexcept {
+#if defined(LANE_ENDIAN_AVX2_DISPATCH)
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+    return supported;
+#elif defined(LANE_ENDIAN_AVX2)
+    return true;
+#else
+    return false;
+#endif
+}
+
+}
+
+void swapEndian(std::uint16_t* values, const std::size_t count) noexcept {
+    swapEndian(values, values, count);
+}
+
+void swapEndian(
+    const std::uint16_t* input,
+    std::uint16_t* output,
+    const std::size_t count
+) noexcept {
+    std::size_t done = 0;
+#ifdef LANE_ENDIAN_AVX2
+    if (hasAvx2()) {
+        done = swapAvx2(input, output, count);
+    }
+#endif
+#ifdef LANE_ENDIAN_SSE2
+    done += swapSse2(input + done, output + done, count - done);
+#endif
+    swapScalar(input + done, output + done, count - done);
+}
+
+std::size_t decodeBigEndianWords(
+    const void* input,
+    std::uint16_t* words,
+    WordType* types,
+    const std::size_t count
+) noexcept {
+    const auto bytes = static_cast<const unsigned char*>(input);
+    std::size_t controls = 0;
+    std::size_t done = 0;
+#ifdef LANE_ENDIAN_AVX2
+    if (hasAvx2()) {
+        done = decodeAvx2(bytes, words, types, count, controls);
+    }
+#endif
+#ifdef LANE_ENDIAN_SSE2
+    done += decodeSse2(
+        bytes + 2 * done,
+        words + done,
+        types + done,
+        count - done,
+        controls
+    );
+#endif
+    return controls + decodeScalar(
+        bytes + 2 * done,
+        words + done,
+        types + done,
+        count - done
+    );
+}
+
+} // utils
+} // lane
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file FileWatcher.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Watches a directory tree for new files by polling it, for
+/// platforms without inotify
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+// Linux uses the inotify watcher in FileWatcherLinux.cpp
+#ifndef __linux__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include "Utils/Filesystem.hpp"
+#include "Utils/FileWatcher.hpp"
+
+namespace lane {
+namespace utils {
+
+struct FileWatcher::State {
+    std::string directory;
+    std::string extension;
+    // Files which haven't been finished yet, and their size when last seen
+    std::map<std::string, std::uint64_t> sizes;
+    // Files which have been reported, or were there to begin with
+    std::set<std::string> known;
+};
+
+namespace {
+
+// How often the directory tree is looked through in milliseconds
+const unsigned int pollInterval = 1000;
+
+}
+
+FileWatcher::FileWatcher(
+    const std::string& directory,
+    const std::string& extension
+)
+: state_(new State) {
+    state_->directory = directory;
+    state_->extension = extension;
+    for (const auto& file : walkDirectory(directory, extension)) {
+        state_->known.insert(file.path);
+    }
+}
+
+FileWatcher::~FileWatcher() noexcept = default;
+
+FileWatcher::FileWatcher(FileWatcher&& other) noexcept = default;
+
+FileWatcher& FileWatcher::operator=(FileWatcher&& other) noexcept = default;
+
+std::vector<std::string> FileWatcher::wait(const unsigned int timeout) {
+    using clock = std::chrono::steady_clock;
+    std::vector<std::string> finished;
+    auto& state = *state_;
+    const auto deadline = clock::now() + std::chrono::milliseconds(timeout);
+    for (;;) {
+        for (const auto& file : walkDirectory(state.directory, state.extension)) {
+            if (state.known.count(file.path) != 0) {
+                continue;
+            }
+            auto seen = state.sizes.find(file.path);
+            if (seen != state.sizes.end() && seen->second == file.size) {
+                finished.emplace_back(file.path);
+                state.known.insert(file.path);
+                state.sizes.erase(seen);
+            } else {
+                state.sizes[file.path] = file.size;
+            }
+        }
+
+        const auto now = clock::now();
+        if (!finished.empty() || now >= deadline) {
+            return finished;
+        }
+        std::this_thread::sleep_for(std::min<clock::duration>(
+            std::chrono::milliseconds(pollInterval),
+            deadline - now
+        ));
+    }
+}
+
+} // utils
+} // lane
+
+#endif // __linux__
@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file FileWatcherLinux.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Watches a directory tree for new files using inotify
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+// Other posix systems use the polling watcher in FileWatcher.cpp
+#ifdef __linux__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include "Utils/Filesystem.hpp"
+#include "Utils/FileWatcher.hpp"
+
+namespace lane {
+namespace utils {
+
+namespace {
+
+// Files are finished when closed after writing or moved in, and new
+// directories need watching too
+const std::uint32_t watchedEvents =
+    IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+
+// How often files found after events were lost are looked at in
+// milliseconds, as for the polling watcher
+const unsigned int pollInterval = 1000;
+
+// Doesn't follow symbolic links, so that linked directories aren't watched
+// and can't make loops
+bool isDirectory(const std::string& path) noexcept {
+    struct stat status;
+    return lstat(path.c_str(), &status) == 0 && S_ISDIR(status.st_mode);
+}
+
+// Watches a directory and those under it, which are already watched being
+// fine. The files with the extension already there are added to found.
+// Throws a std::runtime_error if the directory can't be watched, while
+// those under it which can't be (having gone again) are skipped
+void addWatches(
+    int notifier,
+    const std::string& extension,
+    const std::string& directory,
+    std::map<int, std::string>& directories,
+    std::vector<std::string>& found
+) {
+    const auto descriptor = inotify_add_watch(
+        notifier,
+        directory.c_str(),
+        watchedEvents
+    );
+    if (descriptor < 0) {
+        throw std::runtime_error("Unable to watch directory: " + directory);
+    }
+    directories[descriptor] = directory;
+
+    for (const auto& name : getDirectoryContents(directory)) {
+        const auto path = directory + "/" + name;
+        if (isDirectory(path)) {
+            try {
+                addWatches(notifier, extension, path, directories, found);
+            } catch (const std::runtime_error&) {
+            }
+        } else if (hasExtension(name, extension)) {
+            found.emplace_back(path);
+        }
+    }
+}
+
+}
+
+struct FileWatcher::State {
+    int notifier = -1;
+    std::string directory;
+    std::string extension;
+    // The path of the directory each watch descriptor is for
+    std::map<int, std::string> directories;
+    // Files which have been reported, or were there to begin with
+    std::set<std::string> known;
+    // Files found without an event saying they're finished (after events
+    // were lost, or in a new directory before it was watched), with their
+    // size when last seen, until they're finished
+    std::map<std::string, std::uint64_t> unsettled;
+    std::chrono::steady_clock::time_point lastLook;
+    alignas(struct inotify_event) char buffer[64 * 1024];
+
+    // Adds a file to those reported by a wait. Each file is only reported
+    // once, even if it's written to again afterwards
+    void report(const std::string& path, std::vector<std::string>& finished) {
+        if (known.count(path) != 0) {
+            return;
+        }
+        finished.emplace_back(path);
+        known.insert(path);
+        unsettled.erase(path);
+    }
+
+    // Looks through the whole tree again after the kernel's event queue
+    // overflowed, watching any directories made since and noting the files
+    // which haven't been reported, as their events may have been lost
+    void rescan() {
+        std::vector<std::string> found;
+        addWatches(notifier, extension, directory, directories, found);
+        addUnsettled(found);
+    }
+
+    // Notes files whose events may have been missed, to be reported once
+    // their size stops changing
+    void addUnsettled(const std::vector<std::string>& found) {
+        for (const auto& path : found) {
+            if (known.count(path) == 0 && unsettled.count(path) == 0) {
+                unsettled[path] = getFileSize(path);
+            }
+        }
+        lastLook = std::chrono::steady_clock::now();
+    }
+
+    // Reports the files found by a rescan whose size hasn't changed since
+    // they were last looked at, as they're taken to be finished
+    void reportSettled(std::vector<std::string>& finished) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastLook < std::chrono::milliseconds(pollInterval)) {
+            return;
+        }
+        lastLook = now;
+        std::vector<std::string> settled;
+        for (auto file = unsettled.begin(); file != unsettled.end(); ) {
+            if (!fileExists(file->first)) {
+                file = unsettled.erase(file);
+                continue;
+            }
+            const auto size = getFileSize(file->first);
+            if (size == file->second) {
+                settled.emplace_back(file->first);
+            } else {
+                file->second = size;
+            }
+            ++file;
+        }
+        for (const auto& path : settled) {
+            report(path, finished);
+        }
+    }
+};
+
+FileWatcher::FileWatcher(
+    const std::string& directory,
+    const std::string& extension
+)
+: state_(new State) {
+    state_->directory = directory;
+    state_->extension = extension;
+    state_->notifier = inotify_init1(IN_CLOEXEC);
+    if (state_->notifier < 0) {
+        throw std::runtime_error("Unable to watch directory: " + directory);
+    }
+    std::vector<std::string> found;
+    try {
+        addWatches(
+            state_->notifier,
+            extension,
+            directory,
+            state_->directories,
+            found
+        );
+    } catch (...) {
+        close(state_->notifier);
+        throw;
+    }
+    state_->known.insert(found.begin(), found.end());
+}
+
+FileWatcher::~FileWatcher() noexcept {
+    if (state_ && state_->notifier >= 0) {
+        close(state_->notifier);
+    }
+}
+
+FileWatcher::FileWatcher(FileWatcher&& other) noexcept = default;
+
+FileWatcher& FileWatcher::operator=(FileWatcher&& other) noexcept {
+    if (this != &other) {
+        if (state_ && state_->notifier >= 0) {
+            close(state_->notifier);
+        }
+        state_ = std::move(other.state_);
+    }
+    return *this;
+}
+
+std::vector<std::string> FileWatcher::wait(const unsigned int timeout) {
+    std::vector<std::string> finished;
+    auto& state = *state_;
+
+    // Files found by a rescan are looked at again every poll interval
+    state.reportSettled(finished);
+    if (!finished.empty()) {
+        return finished;
+    }
+    auto wait = timeout;
+    if (!state.unsettled.empty()) {
+        wait = std::min(wait, pollInterval);
+    }
+
+    struct pollfd events;
+    events.fd = state.notifier;
+    events.events = POLLIN;
+    events.revents = 0;
+    const auto ready = poll(&events, 1, static_cast<int>(wait));
+    if (ready == 0 || (ready < 0 && errno == EINTR)) {
+        return finished;
+    }
+    if (ready < 0) {
+        throw std::runtime_error("Unable to wait for file events");
+    }
+    const auto length = read(state.notifier, state.buffer, sizeof(state.buffer));
+    if (length < 0) {
+        if (errno == EINTR || errno == EAGAIN) {
+            return finished;
+        }
+        throw std::runtime_error("Unable to read file events");
+    }
+
+    for (ssize_t offset = 0; offset < length; ) {
+        const auto event = reinterpret_cast<const struct inotify_event*>(
+            state.buffer + offset
+        );
+        offset += sizeof(struct inotify_event) + event->len;
+        if (event->mask & IN_Q_OVERFLOW) {
+            // Events have been lost, so whatever they were for has to be
+            // found by looking through the tree
+            state.rescan();
+            continue;
+        }
+        if (event->mask & IN_IGNORED) {
+            // The directory has gone
+            state.directories.erase(event->wd);
+            continue;
+        }
+        auto directory = state.directories.find(event->wd);
+        if (directory == state.directories.end() || event->len == 0) {
+            continue;
+        }
+        const std::string name = event->name;
+        const auto path = directory->second + "/" + name;
+        if (event->mask & IN_ISDIR) {
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                // The files of a directory moved in were finished elsewhere.
+                // Those of a new directory may still be being written, and
+                // any closed before it was watched have had their events
+                // missed, so they're reported once their size settles (or
+                // when they're closed, if that's sooner)
+                std::vector<std::string> found;
+                try {
+                    addWatches(
+                        state.notifier,
+                        state.extension,
+                        path,
+                        state.directories,
+                        found
+                    );
+                } catch (const std::runtime_error&) {
+                    // The directory may have gone again already
+                }
+                if (event->mask & IN_MOVED_TO) {
+                    for (const auto& file : found) {
+                        state.report(file, finished);
+                    }
+                } else {
+                    state.addUnsettled(found);
+                }
+            }
+        } else if (
+            (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) &&
+            hasExtension(name, state.extension)
+        ) {
+            state.report(path, finished);
+        }
+    }
+    return finished;
+}
+
+} // utils
+} // lane
+
+#endif // __linux__
@@ -13,11 +13,27 @@
 
 #include <vector>
 #include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
 #include "Utils/Filesystem.hpp"
 
 namespace lane {
 namespace utils {
 
+bool fileExists(const std::string& path) noexcept {
+    std::ifstream file(path, std::ios::in);
+    return file.is_open();
+}
+
+std::uint64_t getFileSize(const std::string& path) noexcept {
+    std::ifstream file(path, std::ios::binary | std::ios::in | std::ios::ate);
+    if (!file.is_open()) {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(file.tellg());
+}
+
 std::string getFileName(const std::string& path) noexcept {
     std::string fileName = "";
     
@@ -96,7 +112,7 @@ std::vector<std::string> getFilesWithExtension(
     std::vector<std::string> filesWithExtension;
     
     for (const auto& name : files) {
-        if (getExtension(name) == extension) {
+        if (hasExtension(name, extension)) {
             filesWithExtension.emplace_back(directory + "/" + name);
         }
     }
@@ -111,7 +127,7 @@ std::vector<std::string> getFilesWithExtension(
     std::vector<std::string> filesWithExtension;
     
     for (const auto& name : files) {
-        if (getExtension(name) == extension) {
+        if (hasExtension(name, extension)) {
             filesWithExtension.emplace_back(name);
         }
     }
@@ -119,5 +135,40 @@ std::vector<std::string> getFilesWithExtension(
     return filesWithExtension;
 }
 
+bool hasExtension(
+    const std::string& path,
+    const std::string& extension
+) noexcept {
+    // Matches getExtension, which needs a non-empty extension and a file
+    // name which doesn't start with the dot
+    const auto size = path.size();
+    const auto length = extension.size();
+    if (length == 0 || size < length + 2 || path[size - length - 1] != '.') {
+        return false;
+    }
+    const char before = path[size - length - 2];
+    if (before == '/' || before == '\\') {
+        return false;
+    }
+    for (std::string::size_type i = 0; i < length; ++i) {
+        const char c = extension[i];
+        if (c == '.' || c == '/' || c == '\\') {
+            return false;
+        }
+    }
+    return path.compare(size - length, length, extension) == 0;
+}
+
+void sortLargestFirst(std::vector<FileInfo>& files) noexcept {
+    std::sort(
+        files.begin(),
+        files.end(),
+        [](const FileInfo& lhs, const FileInfo& rhs) {
+            return lhs.size > rhs.size ||
+                (lhs.size == rhs.size && lhs.path < rhs.path);
+        }
+    );
+}
+
 } // utils
 } // lane
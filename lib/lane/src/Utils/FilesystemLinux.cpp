@@ -14,6 +14,11 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdint>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <stdlib.h>
@@ -21,8 +26,90 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <limits.h>
+#include <fcntl.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <sys/sendfile.h>
+#endif
 #include "Utils/Filesystem.hpp"
 
+namespace {
+
+// Closes a file descriptor when it goes out of scope
+struct FileDescriptor {
+    explicit FileDescriptor(const int descriptor) noexcept : fd(descriptor) {}
+    ~FileDescriptor() noexcept {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    int fd;
+};
+
+// Adds the matching files in a directory, and its sub-directories if
+// recursing, to a list
+void walk(
+    const std::string& directory,
+    const std::string& extension,
+    const bool isRecursive,
+    std::vector<lane::utils::FileInfo>& files
+) {
+    DIR* d = opendir(directory.c_str());
+    if (d == NULL) {
+        return;
+    }
+    const int fd = dirfd(d);
+    std::vector<std::string> subdirectories;
+    struct dirent* entry;
+    while ((entry = readdir(d)) != NULL) {
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+            continue;
+        }
+        std::string path = directory + "/" + name;
+        
+        bool isDirectory = entry->d_type == DT_DIR;
+        bool isFile = entry->d_type == DT_REG;
+        if (entry->d_type == DT_UNKNOWN) {
+            // Not every filesystem fills in the type
+            struct stat st;
+            if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+                continue;
+            }
+            isDirectory = S_ISDIR(st.st_mode);
+            isFile = S_ISREG(st.st_mode) || S_ISLNK(st.st_mode);
+        } else if (entry->d_type == DT_LNK) {
+            isFile = true;
+        }
+        
+        if (isDirectory) {
+            if (isRecursive) {
+                subdirectories.emplace_back(std::move(path));
+            }
+        } else if (isFile && (extension.empty() || lane::utils::hasExtension(path, extension))) {
+            // Only matching files are stat'ed, for their size
+            struct stat st;
+            if (fstatat(fd, name, &st, 0) == 0 && S_ISREG(st.st_mode)) {
+                files.push_back(lane::utils::FileInfo{
+                    std::move(path),
+                    static_cast<std::uint64_t>(st.st_size)
+                });
+            }
+        }
+    }
+    closedir(d);
+    
+    // Recurse after closing, so deep trees don't run out of descriptors
+    for (const auto& subdirectory : subdirectories) {
+        walk(subdirectory, extension, isRecursive, files);
+    }
+}
+
+}
+
 namespace lane {
 namespace utils {
 
@@ -50,5 +137,186 @@ std::vector<std::string> getDirectoryContents(
     return fileList;
 }
 
+std::vector<FileInfo> walkDirectory(
+    const std::string& directory,
+    const std::string& extension,
+    const bool isRecursive
+) noexcept {
+    std::vector<FileInfo> files;
+    try {
+        walk(directory, extension, isRecursive, files);
+    } catch (...) {
+        // Out of memory, return what was found
+    }
+    return files;
+}
+
+std::int64_t getModificationTime(const std::string& path) noexcept {
+    struct stat status;
+    if (stat(path.c_str(), &status) != 0) {
+        return 0;
+    }
+    return static_cast<std::int64_t>(status.st_mtim.tv_sec) * 1000000000 +
+        status.st_mtim.tv_nsec;
+}
+
+std::size_t readFileRange(
+    const std::string& fileName,
+    const std::uint64_t offset,
+    void* buffer,
+    const std::size_t size
+) noexcept {
+    FileDescriptor input(open(fileName.c_str(), O_RDONLY));
+    if (input.fd < 0) {
+        return 0;
+    }
+    std::size_t done = 0;
+    while (done < size) {
+        auto result = pread(
+            input.fd,
+            static_cast<char*>(buffer) + done,
+            size - done,
+            static_cast<off_t>(offset + done)
+        );
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            break;
+        }
+        done += result;
+    }
+    return done;
+}
+
+void appendFileRange(
+    const std::string& destination,
+    const std::string& source,
+    const std::uint64_t offset,
+    const std::uint64_t length
+) {
+    FileDescriptor input(open(source.c_str(), O_RDONLY));
+    if (input.fd < 0) {
+        throw std::runtime_error("Unable to open file: " + source);
+    }
+    // Not opened for appending, as copy_file_range doesn't allow it
+    FileDescriptor output(open(destination.c_str(), O_WRONLY | O_CREAT, 0644));
+    if (output.fd < 0) {
+        throw std::runtime_error("Unable to open file: " + destination);
+    }
+    off_t outputOffset = lseek(output.fd, 0, SEEK_END);
+    off_t inputOffset = static_cast<off_t>(offset);
+    std::uint64_t remaining = length;
+
+    // Each way of copying is dropped for the next if the kernel or the file
+    // systems involved don't support it
+#if defined(__linux__) && defined(SYS_copy_file_range)
+    bool isCopyingRange = true;
+#endif
+#if defined(__linux__)
+    bool isSendingFile = true;
+#endif
+    std::vector<char> buffer;
+    while (remaining > 0) {
+        const auto chunk = static_cast<std::size_t>(
+            std::min<std::uint64_t>(remaining, 1 << 30)
+        );
+        ssize_t copied = -1;
+#if defined(__linux__) && defined(SYS_copy_file_range)
+        if (isCopyingRange) {
+            loff_t in = inputOffset, out = outputOffset;
+            copied = syscall(
+                SYS_copy_file_range, input.fd, &in, output.fd, &out, chunk, 0
+            );
+            if (copied < 0 && errno != EINTR) {
+                isCopyingRange = false;
+                continue;
+            }
+        } else
+#endif
+#if defined(__linux__)
+        if (isSendingFile) {
+            // sendfile writes at the output's file position
+            off_t in = inputOffset;
+            lseek(output.fd, outputOffset, SEEK_SET);
+            copied = sendfile(output.fd, input.fd, &in, chunk);
+            if (copied < 0 && (errno == EINVAL || errno == ENOSYS)) {
+                isSendingFile = false;
+                continue;
+            }
+        } else
+#endif
+        {
+            buffer.resize(std::min<std::size_t>(chunk, 1024 * 1024));
+            copied = pread(input.fd, buffer.data(), buffer.size(), inputOffset);
+            if (copied > 0) {
+                ssize_t written = 0;
+                while (written < copied) {
+                    auto result = pwrite(
+                        output.fd,
+                        buffer.data() + written,
+                        copied - written,
+                        outputOffset + written
+                    );
+                    if (result < 0 && errno != EINTR) {
+                        throw std::runtime_error("Unable to write to file: " + destination);
+                    }
+                    written += result > 0 ? result : 0;
+                }
+            }
+        }
+        if (copied < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(
+                "Unable to copy from " + source + " to " + destination
+            );
+        }
+        if (copied == 0) {
+            throw std::runtime_error("Unexpected end of file: " + source);
+        }
+        inputOffset += copied;
+        outputOffset += copied;
+        remaining -= copied;
+    }
+}
+
+bool makeDirectory(const std::string& path) noexcept {
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) {
+        return S_ISDIR(st.st_mode);
+    }
+    try {
+        // Make the parents first, skipping over repeated separators
+        auto separator = path.find_last_of('/');
+        if (separator != std::string::npos && separator > 0) {
+            makeDirectory(path.substr(0, separator));
+        }
+    } catch (...) {
+        return false;
+    }
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool removeDirectory(const std::string& path) noexcept {
+    return rmdir(path.c_str()) == 0;
+}
+
+void linkFile(const std::string& source, const std::string& destination) {
+    if (unlink(destination.c_str()) != 0 && errno != ENOENT) {
+        throw std::runtime_error("Unable to replace file: " + destination);
+    }
+    if (link(source.c_str(), destination.c_str()) == 0) {
+        return;
+    }
+    // Not on the same file system, or it doesn't support hard links
+    struct stat st;
+    if (stat(source.c_str(), &st) != 0) {
+        throw std::runtime_error("Unable to open file: " + source);
+    }
+    appendFileRange(destination, source, 0, static_cast<std::uint64_t>(st.st_size));
+}
+
 } // utils
 } // lane
@@ -13,10 +13,58 @@
 
 #include <vector>
 #include <string>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
 #include <windows.h>
 #include <tchar.h>
 #include "Utils/Filesystem.hpp"
 
+namespace {
+
+// Adds the matching files in a directory, and its sub-directories if
+// recursing, to a list.
+// The listing gives sizes and attributes, so nothing needs to be stat'ed
+void walk(
+    const std::string& directory,
+    const std::string& extension,
+    const bool isRecursive,
+    std::vector<lane::utils::FileInfo>& files
+) {
+    WIN32_FIND_DATAA ffd;
+    HANDLE hFind = FindFirstFileA((directory + "/*").c_str(), &ffd);
+    if (hFind == INVALID_HANDLE_VALUE) {
+        return;
+    }
+    std::vector<std::string> subdirectories;
+    do {
+        std::string name = ffd.cFileName;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        std::string path = directory + "/" + name;
+        if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            // Don't follow links to directories
+            if (isRecursive && !(ffd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+                subdirectories.emplace_back(path);
+            }
+        } else if (extension.empty() || lane::utils::hasExtension(path, extension)) {
+            files.push_back(lane::utils::FileInfo{
+                path,
+                (static_cast<std::uint64_t>(ffd.nFileSizeHigh) << 32) | ffd.nFileSizeLow
+            });
+        }
+    } while (FindNextFileA(hFind, &ffd) != 0);
+    FindClose(hFind);
+
+    for (const auto& subdirectory : subdirectories) {
+        walk(subdirectory, extension, isRecursive, files);
+    }
+}
+
+}
+
 namespace lane {
 namespace utils {
 
@@ -46,5 +94,135 @@ std::vector<std::string> getDirectoryContents(
     return fileList;
 }
 
+std::vector<FileInfo> walkDirectory(
+    const std::string& directory,
+    const std::string& extension,
+    const bool isRecursive
+) noexcept {
+    std::vector<FileInfo> files;
+    try {
+        walk(directory, extension, isRecursive, files);
+    } catch (...) {
+        // Out of memory, return what was found
+    }
+    return files;
+}
+
+std::int64_t getModificationTime(const std::string& path) noexcept {
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(
+        path.c_str(),
+        GetFileExInfoStandard,
+        &attributes
+    )) {
+        return 0;
+    }
+    // FILETIMEs count 100 nanosecond intervals
+    const auto time =
+        (static_cast<std::uint64_t>(attributes.ftLastWriteTime.dwHighDateTime)
+            << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+    return static_cast<std::int64_t>(time) * 100;
+}
+
+std::size_t readFileRange(
+    const std::string& fileName,
+    const std::uint64_t offset,
+    void* buffer,
+    const std::size_t size
+) noexcept {
+    HANDLE file = CreateFileA(
+        fileName.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    // A positioned read, like pread
+    OVERLAPPED position = {};
+    position.Offset = static_cast<DWORD>(offset);
+    position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD read = 0;
+    if (!ReadFile(file, buffer, static_cast<DWORD>(size), &read, &position)) {
+        read = 0;
+    }
+    CloseHandle(file);
+    return read;
+}
+
+void appendFileRange(
+    const std::string& destination,
+    const std::string& source,
+    const std::uint64_t offset,
+    const std::uint64_t length
+) {
+    std::ifstream input(source, std::ios::binary | std::ios::in);
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + source);
+    }
+    std::ofstream output(
+        destination,
+        std::ios::binary | std::ios::out | std::ios::app
+    );
+    if (!output.is_open()) {
+        throw std::runtime_error("Unable to open file: " + destination);
+    }
+
+    input.seekg(offset);
+    std::vector<char> buffer(1024 * 1024);
+    std::uint64_t remaining = length;
+    while (remaining > 0) {
+        auto chunk = std::min<std::uint64_t>(remaining, buffer.size());
+        input.read(buffer.data(), chunk);
+        if (static_cast<std::uint64_t>(input.gcount()) != chunk) {
+            throw std::runtime_error("Unexpected end of file: " + source);
+        }
+        output.write(buffer.data(), chunk);
+        remaining -= chunk;
+    }
+    if (!output) {
+        throw std::runtime_error("Unable to write to file: " + destination);
+    }
+}
+
+bool makeDirectory(const std::string& path) noexcept {
+    auto attributes = GetFileAttributesA(path.c_str());
+    if (attributes != INVALID_FILE_ATTRIBUTES) {
+        return (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    }
+    try {
+        auto separator = path.find_last_of("/\\");
+        if (separator != std::string::npos && separator > 0) {
+            makeDirectory(path.substr(0, separator));
+        }
+    } catch (...) {
+        return false;
+    }
+    return CreateDirectoryA(path.c_str(), NULL) != 0 ||
+        GetLastError() == ERROR_ALREADY_EXISTS;
+}
+
+bool removeDirectory(const std::string& path) noexcept {
+    return RemoveDirectoryA(path.c_str()) != 0;
+}
+
+void linkFile(const std::string& source, const std::string& destination) {
+    if (!DeleteFileA(destination.c_str()) && GetLastError() != ERROR_FILE_NOT_FOUND) {
+        throw std::runtime_error("Unable to replace file: " + destination);
+    }
+    if (CreateHardLinkA(destination.c_str(), source.c_str(), NULL)) {
+        return;
+    }
+    if (!CopyFileA(source.c_str(), destination.c_str(), FALSE)) {
+        throw std::runtime_error(
+            "Unable to copy from " + source + " to " + destination
+        );
+    }
+}
+
 } // utils
 } // lane
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Hash.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Fast non-cryptographic 64-bit hashing of data and files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include "Utils/Endian.hpp"
+#include "Utils/Hash.hpp"
+
+namespace lane {
+namespace utils {
+
+namespace {
+
+// The XXH64 primes
+const std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+const std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+const std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+const std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+const std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+inline std::uint64_t rotateLeft(const std::uint64_t x, const int bits) noexcept {
+    return (x << bits) | (x >> (64 - bits));
+}
+
+// The data is read as little endian whatever the target
+inline std::uint64_t read64(const unsigned char* p) noexcept {
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return isBigEndian() ? swapEndian(value) : value;
+}
+
+inline std::uint32_t read32(const unsigned char* p) noexcept {
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return isBigEndian() ? swapEndian(value) : value;
+}
+
+inline std::uint64_t mixLane(std::uint64_t lane, const std::uint64_t input) noexcept {
+    lane += input * prime2;
+    lane = rotateLeft(lane, 31);
+    return lane * prime1;
+}
+
+inline std::uint64_t mergeLane(std::uint64_t hash, const std::uint64_t lane) noexcept {
+    hash ^= mixLane(0, lane);
+    return hash * prime1 + prime4;
+}
+
+// Mixes in whole 32 byte stripes, returning the number of bytes used
+std::size_t mixStripes(
+    std::uint64_t* lanes,
+    const unsigned char* p,
+    const std::size_t size
+) noexcept {
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        lanes[0] = mixLane(lanes[0], read64(p + i));
+        lanes[1] = mixLane(lanes[1], read64(p + i + 8));
+        lanes[2] = mixLane(lanes[2], read64(p + i + 16));
+        lanes[3] = mixLane(lanes[3], read64(p + i + 24));
+    }
+    return i;
+}
+
+// Mixes in the last (less than 32) bytes and avalanches the result
+std::uint64_t finish(
+    std::uint64_t hash,
+    const unsigned char* p,
+    std::size_t size
+) noexcept {
+    for (; size >= 8; size -= 8, p += 8) {
+        hash ^= mixLane(0, read64(p));
+        hash = rotateLeft(hash, 27) * prime1 + prime4;
+    }
+    if (size >= 4) {
+        hash ^= static_cast<std::uint64_t>(read32(p)) * prime1;
+        hash = rotateLeft(hash, 23) * prime2 + prime3;
+        size -= 4;
+        p += 4;
+    }
+    for (; size > 0; --size, ++p) {
+        hash ^= *p * prime5;
+        hash = rotateLeft(hash, 11) * prime1;
+    }
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+}
+
+Hash64::Hash64(const std::uint64_t seed) noexcept
+: seed_(seed),
+  totalSize_(0),
+  bufferSize_(0) {
+    lanes_[0] = seed + prime1 + prime2;
+    lanes_[1] = seed + prime2;
+    lanes_[2] = seed;
+    lanes_[3] = seed - prime1;
+}
+
+void Hash64::update(const void* data, const std::size_t size) noexcept {
+    auto p = static_cast<const unsigned char*>(data);
+    auto remaining = size;
+    totalSize_ += size;
+
+    // Top up a part filled stripe first
+    if (bufferSize_ > 0) {
+        const auto n = std::min(remaining, sizeof(buffer_) - bufferSize_);
+        std::memcpy(buffer_ + bufferSize_, p, n);
+        bufferSize_ += n;
+        p += n;
+        remaining -= n;
+        if (bufferSize_ < sizeof(buffer_)) {
+            return;
+        }
+        mixStripes(lanes_, buffer_, sizeof(buffer_));
+        bufferSize_ = 0;
+    }
+    const auto used = mixStripes(lanes_, p, remaining);
+    std::memcpy(buffer_, p + used, remaining - used);
+    bufferSize_ = remaining - used;
+}
+
+void Hash64::update(const std::string& text) noexcept {
+    update(text.data(), text.size());
+}
+
+std::uint64_t Hash64::getDigest() const noexcept {
+    std::uint64_t hash;
+    if (totalSize_ >= 32) {
+        hash = rotateLeft(lanes_[0], 1) + rotateLeft(lanes_[1], 7) +
+            rotateLeft(lanes_[2], 12) + rotateLeft(lanes_[3], 18);
+        for (int i = 0; i < 4; ++i) {
+            hash = mergeLane(hash, lanes_[i]);
+        }
+    } else {
+        hash = seed_ + prime5;
+    }
+    hash += totalSize_;
+    return finish(hash, buffer_, bufferSize_);
+}
+
+std::uint64_t hash64(
+    const void* data,
+    const std::size_t size,
+    const std::uint64_t seed
+) noexcept {
+    Hash64 hash(seed);
+    hash.update(data, size);
+    return hash.getDigest();
+}
+
+std::uint64_t hashFile(const std::string& fileName, const std::uint64_t seed) {
+    std::ifstream file(fileName, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+    Hash64 hash(seed);
+    std::vector<char> buffer(1024 * 1024);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        hash.update(buffer.data(), static_cast<std::size_t>(file.gcount()));
+    }
+    if (file.bad()) {
+        throw std::runtime_error("Unable to read file: " + fileName);
+    }
+    return hash.getDigest();
+}
+
+std::string formatHash(const std::uint64_t hash) {
+    const char digits[] = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        text[i] = digits[(hash >> ((15 - i) * 4)) & 0xF];
+    }
+    return text;
+}
+
+} // utils
+} // lane
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file SystemLinux.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Cross-platform process resource usage code - Linux specific
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <limits.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
+#include "Utils/System.hpp"
+
+namespace {
+
+#ifdef __linux__
+// Parses a kernel CPU list such as "0-3,8,10-11"
+std::vector<unsigned int> parseCpuList(const std::string& list) {
+    std::vector<unsigned int> cpus;
+    std::istringstream ranges(list);
+    std::string range;
+    while (std::getline(ranges, range, ',')) {
+        unsigned int first = 0, last = 0;
+        char dash = 0;
+        std::istringstream values(range);
+        if (!(values >> first)) {
+            continue;
+        }
+        if (!(values >> dash) || dash != '-' || !(values >> last)) {
+            last = first;
+        }
+        for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// The preferred memory policy of set_mempolicy, from linux/mempolicy.h
+const int preferredMemoryPolicy = 1;
+#endif
+
+}
+
+namespace lane {
+namespace utils {
+
+// Supports posix systems with a /proc filesystem
+std::uint64_t getResidentMemory() noexcept {
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t size = 0, resident = 0;
+    if (!(statm >> size >> resident)) {
+        return 0;
+    }
+    return resident * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+std::uint64_t getPeakResidentMemory() noexcept {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    // Reported in bytes on OS X
+    return usage.ru_maxrss;
+#else
+    // Reported in kilobytes elsewhere
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+std::string getExecutablePath() noexcept {
+    try {
+#ifdef __APPLE__
+        std::uint32_t size = 0;
+        _NSGetExecutablePath(nullptr, &size);
+        std::vector<char> path(size + 1, '\0');
+        if (_NSGetExecutablePath(path.data(), &size) != 0) {
+            return "";
+        }
+        return path.data();
+#else
+        char path[PATH_MAX];
+        auto length = readlink("/proc/self/exe", path, sizeof(path));
+        if (length <= 0 || length == sizeof(path)) {
+            return "";
+        }
+        return std::string(path, length);
+#endif
+    } catch (...) {
+        return "";
+    }
+}
+
+std::vector<NumaNode> getNumaNodes() {
+    std::vector<NumaNode> nodes;
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool isAllowedKnown =
+        sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    auto isAllowed = [&](const unsigned int cpu) {
+        return !isAllowedKnown || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+    };
+
+    // Node numbers can have gaps, so keep looking a little past a missing one
+    for (unsigned int id = 0, missing = 0; missing < 64; ++id) {
+        std::ifstream cpulist(
+            "/sys/devices/system/node/node" + std::to_string(id) + "/cpulist"
+        );
+        std::string list;
+        if (!std::getline(cpulist, list)) {
+            ++missing;
+            continue;
+        }
+        missing = 0;
+        NumaNode node;
+        node.id = id;
+        for (const auto cpu : parseCpuList(list)) {
+            if (isAllowed(cpu)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        // Nodes with only memory on them aren't any use to run on
+        if (!node.cpus.empty()) {
+            nodes.emplace_back(std::move(node));
+        }
+    }
+    if (nodes.empty() && isAllowedKnown) {
+        NumaNode node;
+        node.id = 0;
+        for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                node.cpus.push_back(cpu);
+            }
+        }
+        nodes.emplace_back(std::move(node));
+    }
+#endif
+    if (nodes.empty() || nodes[0].cpus.empty()) {
+        nodes.assign(1, NumaNode());
+        nodes[0].id = 0;
+        const auto count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int cpu = 0; cpu < count; ++cpu) {
+            nodes[0].cpus.push_back(cpu);
+        }
+    }
+    return nodes;
+}
+
+bool setThreadAffinity(const std::vector<unsigned int>& cpus) noexcept {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0 && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    // OS X only offers affinity hints between threads
+    (void)cpus;
+    return false;
+#endif
+}
+
+bool setThreadMemoryNode(const unsigned int nodeID) noexcept {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    const unsigned int maskBits = sizeof(unsigned long) * 8;
+    if (nodeID >= maskBits) {
+        return false;
+    }
+    unsigned long mask = 1UL << nodeID;
+    return syscall(
+        SYS_set_mempolicy, preferredMemoryPolicy, &mask, maskBits
+    ) == 0;
+#else
+    (void)nodeID;
+    return false;
+#endif
+}
+
+} // utils
+} // lane
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file SystemWindows.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Cross-platform process resource usage code - Windows specific
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <windows.h>
+#include <psapi.h>
+#include "Utils/System.hpp"
+
+namespace lane {
+namespace utils {
+
+std::uint64_t getResidentMemory() noexcept {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.WorkingSetSize;
+}
+
+std::uint64_t getPeakResidentMemory() noexcept {
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+}
+
+std::string getExecutablePath() noexcept {
+    char path[MAX_PATH];
+    auto length = GetModuleFileNameA(NULL, path, MAX_PATH);
+    if (length == 0 || length == MAX_PATH) {
+        return "";
+    }
+    try {
+        return std::string(path, length);
+    } catch (...) {
+        return "";
+    }
+}
+
+std::vector<NumaNode> getNumaNodes() {
+    std::vector<NumaNode> nodes;
+    DWORD_PTR processMask = 0, systemMask = 0;
+    GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask);
+    ULONG highestNode = 0;
+    if (GetNumaHighestNodeNumber(&highestNode)) {
+        for (ULONG id = 0; id <= highestNode; ++id) {
+            ULONGLONG nodeMask = 0;
+            if (!GetNumaNodeProcessorMask(static_cast<UCHAR>(id), &nodeMask)) {
+                continue;
+            }
+            NumaNode node;
+            node.id = id;
+            for (unsigned int cpu = 0; cpu < sizeof(DWORD_PTR) * 8; ++cpu) {
+                const DWORD_PTR bit = static_cast<DWORD_PTR>(1) << cpu;
+                if ((nodeMask & bit) && (processMask == 0 || (processMask & bit))) {
+                    node.cpus.push_back(cpu);
+                }
+            }
+            if (!node.cpus.empty()) {
+                nodes.emplace_back(std::move(node));
+            }
+        }
+    }
+    if (nodes.empty()) {
+        nodes.assign(1, NumaNode());
+        nodes[0].id = 0;
+        const auto count = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned int cpu = 0; cpu < count; ++cpu) {
+            nodes[0].cpus.push_back(cpu);
+        }
+    }
+    return nodes;
+}
+
+bool setThreadAffinity(const std::vector<unsigned int>& cpus) noexcept {
+    // Only the first processor group is supported
+    DWORD_PTR mask = 0;
+    for (const auto cpu : cpus) {
+        if (cpu < sizeof(DWORD_PTR) * 8) {
+            mask |= static_cast<DWORD_PTR>(1) << cpu;
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+}
+
+bool setThreadMemoryNode(const unsigned int nodeID) noexcept {
+    // Windows allocates from the node of the thread's processor by default
+    (void)nodeID;
+    return false;
+}
+
+} // utils
+} // lane
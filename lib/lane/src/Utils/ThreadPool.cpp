@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ThreadPool.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief A pool of worker threads shared by the parallel parts of lane
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <memory>
+#include <vector>
+#include <list>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <algorithm>
+#include <cstddef>
+#include "Utils/System.hpp"
+#include "Utils/ThreadPool.hpp"
+
+namespace lane {
+namespace utils {
+
+namespace {
+
+// A parallel loop being run on the pool
+struct Loop {
+    const std::function<void(std::size_t)>* task;
+    std::size_t count;
+    // The next task to hand out, and the number being run
+    std::size_t next;
+    std::size_t running;
+    // The number of workers helping, and the most allowed
+    unsigned int helpers;
+    unsigned int maxHelpers;
+    std::exception_ptr error;
+    std::condition_variable finished;
+};
+
+// Where a worker runs: the CPUs it's bound to and its NUMA node, if any
+struct Placement {
+    std::vector<unsigned int> cpus;
+    bool isBindingMemory = false;
+    unsigned int nodeID = 0;
+};
+
+// Works out where each worker runs. Workers are dealt out round robin over
+// the nodes when binding to them, then over the CPUs of each node
+std::vector<Placement> getPlacements(
+    const ThreadPoolSettings& settings,
+    const unsigned int workers
+) {
+    std::vector<Placement> placements(workers);
+    if (!settings.isPinning && !settings.isNumaBinding) {
+        return placements;
+    }
+    auto nodes = getNumaNodes();
+    if (!settings.isNumaBinding) {
+        // Pinning alone treats every CPU the same
+        for (std::size_t n = 1; n < nodes.size(); ++n) {
+            nodes[0].cpus.insert(
+                nodes[0].cpus.end(),
+                nodes[n].cpus.begin(),
+                nodes[n].cpus.end()
+            );
+        }
+        nodes.resize(1);
+    }
+    // The thread running a loop is the first on the first node, so the
+    // workers start after it
+    std::vector<std::size_t> used(nodes.size(), 0);
+    used[0] = 1;
+    for (unsigned int i = 0; i < workers; ++i) {
+        const auto n = (i + 1) % nodes.size();
+        const auto& node = nodes[n];
+        auto& placement = placements[i];
+        if (settings.isPinning) {
+            placement.cpus.push_back(node.cpus[used[n]++ % node.cpus.size()]);
+        } else {
+            placement.cpus = node.cpus;
+        }
+        placement.isBindingMemory = settings.isNumaBinding;
+        placement.nodeID = node.id;
+    }
+    return placements;
+}
+
+}
+
+struct ThreadPool::State {
+    std::mutex mutex;
+    std::condition_variable work;
+    std::list<Loop*> loops;
+    bool isStopping = false;
+    std::vector<std::thread> workers;
+
+    // Runs tasks of a loop until there are none left to hand out. Called
+    // with the lock held, which is released while each task runs
+    void runTasks(Loop& loop, std::unique_lock<std::mutex>& lock) {
+        while (loop.next < loop.count) {
+            const auto i = loop.next++;
+            ++loop.running;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                (*loop.task)(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            --loop.running;
+            if (error) {
+                if (!loop.error) {
+                    loop.error = error;
+                }
+                loop.next = loop.count;
+            }
+        }
+        loop.finished.notify_all();
+    }
+
+    // Finds a loop which could do with another helper
+    Loop* findLoop() noexcept {
+        for (auto loop : loops) {
+            if (loop->next < loop->count && loop->helpers < loop->maxHelpers) {
+                return loop;
+            }
+        }
+        return nullptr;
+    }
+
+    void runWorker(const Placement& placement) {
+        if (!placement.cpus.empty()) {
+            setThreadAffinity(placement.cpus);
+        }
+        if (placement.isBindingMemory) {
+            setThreadMemoryNode(placement.nodeID);
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            Loop* loop = nullptr;
+            work.wait(lock, [&]() {
+                return isStopping || (loop = findLoop()) != nullptr;
+            });
+            if (isStopping) {
+                return;
+            }
+            ++loop->helpers;
+            runTasks(*loop, lock);
+            --loop->helpers;
+            loop->finished.notify_all();
+        }
+    }
+};
+
+ThreadPool::ThreadPool(const ThreadPoolSettings& settings)
+: state_(new State()) {
+    auto threads = settings.threads;
+    if (threads == 0) {
+        for (const auto& node : getNumaNodes()) {
+            threads += static_cast<unsigned int>(node.cpus.size());
+        }
+    }
+    threads = std::max(1u, threads);
+    const auto placements = getPlacements(settings, threads - 1);
+    for (const auto& placement : placements) {
+        state_->workers.emplace_back([this, placement]() {
+            state_->runWorker(placement);
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->isStopping = true;
+    }
+    state_->work.notify_all();
+    for (auto& worker : state_->workers) {
+        worker.join();
+    }
+}
+
+unsigned int ThreadPool::getThreadCount() const noexcept {
+    return static_cast<unsigned int>(state_->workers.size()) + 1;
+}
+
+void ThreadPool::parallelFor(
+    const std::size_t count,
+    const std::function<void(std::size_t)>& task,
+    const unsigned int threads
+) {
+    if (count == 0) {
+        return;
+    }
+    Loop loop;
+    loop.task = &task;
+    loop.count = count;
+    loop.next = 0;
+    loop.running = 0;
+    loop.helpers = 0;
+    auto limit = threads == 0 ? getThreadCount() : std::min(threads, getThreadCount());
+    loop.maxHelpers = static_cast<unsigned int>(
+        std::min<std::size_t>(limit, count) - 1
+    );
+
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    std::list<Loop*>::iterator position;
+    if (loop.maxHelpers > 0) {
+        position = state_->loops.insert(state_->loops.end(), &loop);
+        state_->work.notify_all();
+    }
+    state_->runTasks(loop, lock);
+    // The helpers have to be done with the loop before it goes away
+    loop.finished.wait(lock, [&]() {
+        return loop.running == 0 && loop.helpers == 0;
+    });
+    if (loop.maxHelpers > 0) {
+        state_->loops.erase(position);
+    }
+    lock.unlock();
+    if (loop.error) {
+        std::rethrow_exception(loop.error);
+    }
+}
+
+namespace {
+
+std::mutex sharedMutex;
+std::unique_ptr<ThreadPool> sharedPool;
+ThreadPoolSettings sharedSettings;
+
+}
+
+ThreadPool& ThreadPool::getShared() {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (!sharedPool) {
+        sharedPool.reset(new ThreadPool(sharedSettings));
+    }
+    return *sharedPool;
+}
+
+void ThreadPool::configureShared(const ThreadPoolSettings& settings) {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    sharedSettings = settings;
+    sharedPool.reset();
+    sharedPool.reset(new ThreadPool(sharedSettings));
+}
+
+} // utils
+} // lane
@@ -0,0 +1,214 @@
+/*****************************************************************************/
+/** \file lanec.h
+ *  \author Hector Stalker <hstalker0@gmail.com>
+ *  \version 0.1
+ *
+ *  \brief C interface to the lane library, for use from other languages
+ *  (e.g. Python via ctypes or cffi).
+ *
+ *  Frames, pixels and cluster feature columns are handed out as pointers to
+ *  contiguous arrays of fixed layout structs or doubles owned by the library,
+ *  so they can be wrapped without copying. Pointers stay valid until the
+ *  object they came from is closed/freed (or for lane_reader_next, until the
+ *  next call). Functions which fail return NULL or a negative value, and
+ *  lane_last_error() describes the failure.
+ *
+ *  \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+ *  This file is under the Simplified (2-clause) BSD license
+ *  For conditions of distribution and use, see:
+ *  http://opensource.org/licenses/BSD-2-Clause
+ *  or read the 'LICENSE.md' file distributed with this code
+ */
+
+#ifndef LANEC_H
+#define LANEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#   if defined(LANEC_BUILD)
+#       define LANEC_API __declspec(dllexport)
+#   else
+#       define LANEC_API __declspec(dllimport)
+#   endif
+#elif defined(__GNUC__)
+#   define LANEC_API __attribute__((visibility("default")))
+#else
+#   define LANEC_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The version of this interface, bumped on any incompatible change */
+#define LANEC_ABI_VERSION 1
+
+/** A frame's details, and where its pixels are in the pixel array */
+typedef struct lane_frame_info {
+    uint32_t channel;
+    uint32_t time_stamp;
+    uint32_t time_stamp_sub;
+    uint32_t pixel_count;
+    /** Index of the frame's first pixel in its pixel array */
+    uint64_t pixel_offset;
+} lane_frame_info;
+
+/** The details of an event, the frames every chip took in one exposure */
+typedef struct lane_event_info {
+    uint32_t time_stamp;
+    uint32_t time_stamp_sub;
+    /** The number of frames (chips) in the event */
+    uint32_t frame_count;
+    /** The number of pixels over all the frames of the event */
+    uint32_t pixel_count;
+} lane_event_info;
+
+/** A hit pixel */
+typedef struct lane_pixel {
+    uint16_t x;
+    uint16_t y;
+    /** The count (TOT) of the pixel */
+    uint32_t c;
+} lane_pixel;
+
+/** A LANE file loaded into memory */
+typedef struct lane_file lane_file;
+
+/** A LANE file channel being read one frame at a time */
+typedef struct lane_reader lane_reader;
+
+/** The channels of a LANE file being joined into events, one at a time */
+typedef struct lane_events lane_events;
+
+/** A query over cluster table (.lct) files */
+typedef struct lane_query lane_query;
+
+/** The result of a cluster table query */
+typedef struct lane_result lane_result;
+
+
+/** Gets the version of the interface the library was built with */
+LANEC_API uint32_t lane_abi_version(void);
+
+/** Gets a description of the last error on the calling thread */
+LANEC_API const char* lane_last_error(void);
+
+
+/** Loads a LANE file, parsing it with the given number of threads */
+LANEC_API lane_file* lane_file_open(const char* path, unsigned int threads);
+
+LANEC_API void lane_file_close(lane_file* file);
+
+/** Gets the number of channels in the file */
+LANEC_API size_t lane_file_channel_count(const lane_file* file);
+
+/** Gets the ID of the index-th channel, in increasing ID order */
+LANEC_API uint32_t lane_file_channel_id(const lane_file* file, size_t index);
+
+/** Gets the number of frames in a channel */
+LANEC_API size_t lane_file_frame_count(const lane_file* file, uint32_t channel);
+
+/** Gets the frames of a channel in time order, or NULL if there are none */
+LANEC_API const lane_frame_info* lane_file_frames(
+    const lane_file* file,
+    uint32_t channel
+);
+
+/** Gets the number of pixels over all frames of a channel */
+LANEC_API size_t lane_file_pixel_count(const lane_file* file, uint32_t channel);
+
+/** Gets the pixels of all frames of a channel, frame after frame */
+LANEC_API const lane_pixel* lane_file_pixels(
+    const lane_file* file,
+    uint32_t channel
+);
+
+
+/** Opens a channel of a LANE file for reading a frame at a time, without
+ *  loading the whole file. Uses (and if needed, builds) the file's index */
+LANEC_API lane_reader* lane_reader_open(const char* path, uint32_t channel);
+
+LANEC_API void lane_reader_close(lane_reader* reader);
+
+/** Reads the next frame. Stores its details in frame (with a pixel_offset
+ *  of 0) and points pixels at its pixels. Returns 1 if a frame was read, 0 at
+ *  the end of the channel and -1 on error */
+LANEC_API int lane_reader_next(
+    lane_reader* reader,
+    lane_frame_info* frame,
+    const lane_pixel** pixels
+);
+
+
+/** Opens a LANE file for reading its channels an event at a time, joining
+ *  frames with the same time stamps. Streams every channel through the
+ *  file's index (building it if needed) instead of loading the whole file */
+LANEC_API lane_events* lane_events_open(const char* path);
+
+LANEC_API void lane_events_close(lane_events* events);
+
+/** Reads the next event. Stores its details in event, points frames at its
+ *  frames in channel order and pixels at the pixels of all of them, frame
+ *  after frame. Returns 1 if an event was read, 0 at the end of the file and
+ *  -1 on error */
+LANEC_API int lane_events_next(
+    lane_events* events,
+    lane_event_info* event,
+    const lane_frame_info** frames,
+    const lane_pixel** pixels
+);
+
+
+/** Creates a query selecting every column of every row */
+LANEC_API lane_query* lane_query_create(void);
+
+LANEC_API void lane_query_free(lane_query* query);
+
+/** Adds a column to output. Returns 0 on success, -1 on error */
+LANEC_API int lane_query_select(lane_query* query, const char* column);
+
+/** Adds a condition that min <= column <= max. Returns 0 on success, -1 on
+ *  error */
+LANEC_API int lane_query_where(
+    lane_query* query,
+    const char* column,
+    double min,
+    double max
+);
+
+/** Runs a query over a number of table files */
+LANEC_API lane_result* lane_query_run(
+    const lane_query* query,
+    const char* const* paths,
+    size_t count
+);
+
+LANEC_API void lane_result_free(lane_result* result);
+
+LANEC_API size_t lane_result_row_count(const lane_result* result);
+
+LANEC_API size_t lane_result_column_count(const lane_result* result);
+
+LANEC_API const char* lane_result_column_name(
+    const lane_result* result,
+    size_t column
+);
+
+/** Gets the values of a column, one per row */
+LANEC_API const double* lane_result_column(
+    const lane_result* result,
+    size_t column
+);
+
+/** Gets the number of blocks read, and skipped using their statistics */
+LANEC_API uint64_t lane_result_blocks_scanned(const lane_result* result);
+
+LANEC_API uint64_t lane_result_blocks_skipped(const lane_result* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LANEC_H */
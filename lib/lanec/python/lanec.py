@@ -0,0 +1,334 @@
+#!/usr/bin/env python
+"""ctypes wrapper around the lanec library.
+
+Frame and pixel arrays are views onto memory owned by the library, so no
+data is copied. When numpy is available they are returned as numpy arrays
+(structured for frames and pixels), otherwise as ctypes arrays. A view
+keeps the library memory it refers to alive, so it stays readable after the
+object it came from is closed; the memory is freed once both are gone.
+
+The library is loaded from the LANEC_LIBRARY environment variable if set,
+otherwise from the directory this file is in.
+"""
+import os, sys, ctypes
+
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
+ABI_VERSION = 1
+
+class FrameInfo(ctypes.Structure):
+    _fields_ = [
+        ('channel', ctypes.c_uint32),
+        ('time_stamp', ctypes.c_uint32),
+        ('time_stamp_sub', ctypes.c_uint32),
+        ('pixel_count', ctypes.c_uint32),
+        ('pixel_offset', ctypes.c_uint64),
+    ]
+
+class EventInfo(ctypes.Structure):
+    _fields_ = [
+        ('time_stamp', ctypes.c_uint32),
+        ('time_stamp_sub', ctypes.c_uint32),
+        ('frame_count', ctypes.c_uint32),
+        ('pixel_count', ctypes.c_uint32),
+    ]
+
+class Pixel(ctypes.Structure):
+    _fields_ = [
+        ('x', ctypes.c_uint16),
+        ('y', ctypes.c_uint16),
+        ('c', ctypes.c_uint32),
+    ]
+
+class LaneError(Exception):
+    pass
+
+def _libraryPath():
+    path = os.environ.get('LANEC_LIBRARY')
+    if path:
+        return path
+    if sys.platform.startswith('win'):
+        name = 'lanec.dll'
+    elif sys.platform == 'darwin':
+        name = 'liblanec.dylib'
+    else:
+        name = 'liblanec.so'
+    return os.path.join(os.path.dirname(os.path.abspath(__file__)), name)
+
+def _load():
+    lib = ctypes.CDLL(_libraryPath())
+    c_size = ctypes.c_size_t
+    c_u32 = ctypes.c_uint32
+    c_u64 = ctypes.c_uint64
+    c_void = ctypes.c_void_p
+    c_str = ctypes.c_char_p
+    signatures = {
+        'lane_abi_version': (c_u32, []),
+        'lane_last_error': (c_str, []),
+        'lane_file_open': (c_void, [c_str, ctypes.c_uint]),
+        'lane_file_close': (None, [c_void]),
+        'lane_file_channel_count': (c_size, [c_void]),
+        'lane_file_channel_id': (c_u32, [c_void, c_size]),
+        'lane_file_frame_count': (c_size, [c_void, c_u32]),
+        'lane_file_frames': (ctypes.POINTER(FrameInfo), [c_void, c_u32]),
+        'lane_file_pixel_count': (c_size, [c_void, c_u32]),
+        'lane_file_pixels': (ctypes.POINTER(Pixel), [c_void, c_u32]),
+        'lane_reader_open': (c_void, [c_str, c_u32]),
+        'lane_reader_close': (None, [c_void]),
+        'lane_reader_next': (ctypes.c_int, [
+            c_void,
+            ctypes.POINTER(FrameInfo),
+            ctypes.POINTER(ctypes.POINTER(Pixel))
+        ]),
+        'lane_events_open': (c_void, [c_str]),
+        'lane_events_close': (None, [c_void]),
+        'lane_events_next': (ctypes.c_int, [
+            c_void,
+            ctypes.POINTER(EventInfo),
+            ctypes.POINTER(ctypes.POINTER(FrameInfo)),
+            ctypes.POINTER(ctypes.POINTER(Pixel))
+        ]),
+        'lane_query_create': (c_void, []),
+        'lane_query_free': (None, [c_void]),
+        'lane_query_select': (ctypes.c_int, [c_void, c_str]),
+        'lane_query_where': (ctypes.c_int, [
+            c_void, c_str, ctypes.c_double, ctypes.c_double
+        ]),
+        'lane_query_run': (c_void, [c_void, ctypes.POINTER(c_str), c_size]),
+        'lane_result_free': (None, [c_void]),
+        'lane_result_row_count': (c_size, [c_void]),
+        'lane_result_column_count': (c_size, [c_void]),
+        'lane_result_column_name': (c_str, [c_void, c_size]),
+        'lane_result_column': (ctypes.POINTER(ctypes.c_double), [c_void, c_size]),
+        'lane_result_blocks_scanned': (c_u64, [c_void]),
+        'lane_result_blocks_skipped': (c_u64, [c_void]),
+    }
+    for name, (restype, argtypes) in signatures.items():
+        function = getattr(lib, name)
+        function.restype = restype
+        function.argtypes = argtypes
+    if lib.lane_abi_version() != ABI_VERSION:
+        raise LaneError('lanec ABI version mismatch')
+    return lib
+
+_lib = _load()
+
+def _encode(s):
+    return s.encode('utf-8') if not isinstance(s, bytes) else s
+
+def _decode(s):
+    return s.decode('utf-8') if isinstance(s, bytes) else s
+
+def _error():
+    return LaneError(_decode(_lib.lane_last_error()))
+
+class _Handle(object):
+    """Owns a library handle, freeing it once nothing refers to it"""
+    def __init__(self, pointer, free):
+        self.pointer = pointer
+        self._free = free
+
+    def __del__(self):
+        self._free(self.pointer)
+
+class _Closable(object):
+    """Base for objects whose views refer to their handle, so that closing
+    them only lets go of the handle instead of freeing it under the views"""
+    def __init__(self, pointer, free):
+        if not pointer:
+            raise _error()
+        self._handle = _Handle(pointer, free)
+
+    def close(self):
+        self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _pointer(self):
+        if self._handle is None:
+            raise LaneError('%s is closed' % type(self).__name__)
+        return self._handle.pointer
+
+def _view(pointer, count, ctype, owner):
+    """Wraps library memory as an array without copying it"""
+    if count == 0 or not pointer:
+        if numpy is not None:
+            return numpy.zeros(0, dtype=numpy.dtype(ctype))
+        return (ctype * 0)()
+    array = ctypes.cast(pointer, ctypes.POINTER(ctype * count)).contents
+    # Keep the owner alive for as long as the view is
+    array._owner = owner
+    if numpy is not None:
+        return numpy.frombuffer(array, dtype=numpy.dtype(ctype))
+    return array
+
+class LaneFile(_Closable):
+    """All the frames of a .lane file, loaded with a number of threads"""
+    def __init__(self, path, threads=0):
+        _Closable.__init__(
+            self,
+            _lib.lane_file_open(_encode(path), threads),
+            _lib.lane_file_close
+        )
+
+    def channels(self):
+        handle = self._pointer()
+        count = _lib.lane_file_channel_count(handle)
+        return [_lib.lane_file_channel_id(handle, i) for i in range(count)]
+
+    def frames(self, channel):
+        """The frames of a channel. pixel_offset indexes into pixels()"""
+        handle = self._pointer()
+        count = _lib.lane_file_frame_count(handle, channel)
+        pointer = _lib.lane_file_frames(handle, channel)
+        return _view(pointer, count, FrameInfo, self._handle)
+
+    def pixels(self, channel):
+        """The pixels of all the frames of a channel, in frame order"""
+        handle = self._pointer()
+        count = _lib.lane_file_pixel_count(handle, channel)
+        pointer = _lib.lane_file_pixels(handle, channel)
+        return _view(pointer, count, Pixel, self._handle)
+
+class Reader(_Closable):
+    """Streams the frames of one channel of a .lane file, using its .lidx
+    index. Iterating gives (FrameInfo, pixels) pairs; the pixels are
+    overwritten when the next frame is read, so copy them to keep them."""
+    def __init__(self, path, channel):
+        _Closable.__init__(
+            self,
+            _lib.lane_reader_open(_encode(path), channel),
+            _lib.lane_reader_close
+        )
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        frame = FrameInfo()
+        pixels = ctypes.POINTER(Pixel)()
+        status = _lib.lane_reader_next(
+            self._pointer(), ctypes.byref(frame), ctypes.byref(pixels)
+        )
+        if status < 0:
+            raise _error()
+        if status == 0:
+            raise StopIteration
+        return frame, _view(pixels, frame.pixel_count, Pixel, self._handle)
+
+    next = __next__
+
+class Events(_Closable):
+    """Streams the events of a .lane file, the frames every chip took in one
+    exposure, joined on their time stamps. Iterating gives (EventInfo,
+    frames, pixels) tuples, where pixel_offset of each frame indexes into
+    pixels; both are overwritten when the next event is read, so copy them
+    to keep them."""
+    def __init__(self, path):
+        _Closable.__init__(
+            self,
+            _lib.lane_events_open(_encode(path)),
+            _lib.lane_events_close
+        )
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        event = EventInfo()
+        frames = ctypes.POINTER(FrameInfo)()
+        pixels = ctypes.POINTER(Pixel)()
+        status = _lib.lane_events_next(
+            self._pointer(),
+            ctypes.byref(event),
+            ctypes.byref(frames),
+            ctypes.byref(pixels)
+        )
+        if status < 0:
+            raise _error()
+        if status == 0:
+            raise StopIteration
+        return (
+            event,
+            _view(frames, event.frame_count, FrameInfo, self._handle),
+            _view(pixels, event.pixel_count, Pixel, self._handle)
+        )
+
+    next = __next__
+
+class Query(object):
+    """A query over cluster tables (.lct files) written by BCA"""
+    def __init__(self, columns=None):
+        self._handle = _lib.lane_query_create()
+        if not self._handle:
+            raise _error()
+        for column in columns or []:
+            self.select(column)
+
+    def __del__(self):
+        if self._handle:
+            _lib.lane_query_free(self._handle)
+            self._handle = None
+
+    def select(self, column):
+        if _lib.lane_query_select(self._handle, _encode(column)) != 0:
+            raise _error()
+        return self
+
+    def where(self, column, minimum, maximum):
+        if _lib.lane_query_where(
+            self._handle, _encode(column), minimum, maximum
+        ) != 0:
+            raise _error()
+        return self
+
+    def run(self, paths):
+        """Runs the query over the tables, returning a Result"""
+        if isinstance(paths, (str, bytes)):
+            paths = [paths]
+        encoded = [_encode(p) for p in paths]
+        array = (ctypes.c_char_p * len(encoded))(*encoded)
+        handle = _lib.lane_query_run(self._handle, array, len(encoded))
+        if not handle:
+            raise _error()
+        return Result(handle)
+
+class Result(object):
+    """The columns matched by a Query"""
+    def __init__(self, handle):
+        self._handle = handle
+
+    def __del__(self):
+        if self._handle:
+            _lib.lane_result_free(self._handle)
+            self._handle = None
+
+    def __len__(self):
+        return _lib.lane_result_row_count(self._handle)
+
+    def columns(self):
+        count = _lib.lane_result_column_count(self._handle)
+        return [
+            _decode(_lib.lane_result_column_name(self._handle, i))
+            for i in range(count)
+        ]
+
+    def column(self, name):
+        """The values of a column, by name or index"""
+        if not isinstance(name, int):
+            name = self.columns().index(name)
+        pointer = _lib.lane_result_column(self._handle, name)
+        return _view(pointer, len(self), ctypes.c_double, self)
+
+    def blocksScanned(self):
+        return _lib.lane_result_blocks_scanned(self._handle)
+
+    def blocksSkipped(self):
+        return _lib.lane_result_blocks_skipped(self._handle)
@@ -0,0 +1,407 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneC.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief C interface to the lane library, for use from other languages
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <map>
+#include <exception>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include "lanec.h"
+#include "Frame.hpp"
+#include "LaneFile.hpp"
+#include "LaneFileReader.hpp"
+#include "EventBuilder.hpp"
+#include "ClusterTable.hpp"
+
+struct lane_file {
+    struct Channel {
+        std::vector<lane_frame_info> frames;
+        std::vector<lane_pixel> pixels;
+    };
+
+    std::vector<std::uint32_t> channelIDs;
+    std::map<std::uint32_t, Channel> channels;
+};
+
+struct lane_reader {
+    lane_reader(const char* path, const std::uint32_t channel)
+    : reader(path, channel) {
+    }
+
+    lane::LaneFileReader reader;
+    lane::Frame frame;
+    std::vector<lane_pixel> pixels;
+};
+
+struct lane_events {
+    explicit lane_events(const char* path) {
+        builder.addLaneFile(path);
+    }
+
+    lane::EventBuilder builder;
+    lane::Event event;
+    std::vector<lane_frame_info> frames;
+    std::vector<lane_pixel> pixels;
+};
+
+struct lane_query {
+    lane::ClusterQuery query;
+    std::vector<std::string> columns;
+};
+
+struct lane_result {
+    lane::QueryResult result;
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+void setError(const std::exception& e) {
+    lastError = e.what();
+}
+
+void setUnknownError() {
+    lastError = "Unknown error";
+}
+
+// Appends a frame's pixels to a pixel array, filling in its details
+void addFrame(
+    const lane::Frame& frame,
+    lane_frame_info& info,
+    std::vector<lane_pixel>& pixels
+) {
+    info.channel = frame.getChannelID();
+    info.time_stamp = frame.getTimeStamp();
+    info.time_stamp_sub = frame.getTimeStampSub();
+    info.pixel_count = static_cast<std::uint32_t>(frame.getPixels().size());
+    info.pixel_offset = pixels.size();
+    for (const auto& p : frame.getPixels()) {
+        lane_pixel pixel;
+        pixel.x = static_cast<std::uint16_t>(p.second.getX());
+        pixel.y = static_cast<std::uint16_t>(p.second.getY());
+        pixel.c = p.second.getC();
+        pixels.push_back(pixel);
+    }
+}
+
+const lane_file::Channel* findChannel(
+    const lane_file* file,
+    const std::uint32_t channel
+) {
+    if (file == nullptr) {
+        return nullptr;
+    }
+    auto it = file->channels.find(channel);
+    return it == file->channels.end() ? nullptr : &it->second;
+}
+
+}
+
+extern "C" {
+
+uint32_t lane_abi_version(void) {
+    return LANEC_ABI_VERSION;
+}
+
+const char* lane_last_error(void) {
+    return lastError.c_str();
+}
+
+lane_file* lane_file_open(const char* path, unsigned int threads) {
+    try {
+        lane::LaneFile laneFile(path, threads);
+        auto file = new lane_file;
+        file->channelIDs = laneFile.getChannelIDs();
+        for (const auto channelID : file->channelIDs) {
+            auto& channel = file->channels[channelID];
+            auto frames = laneFile.getFrames(channelID);
+            channel.frames.resize(frames.size());
+            for (std::size_t i = 0; i < frames.size(); ++i) {
+                addFrame(frames[i], channel.frames[i], channel.pixels);
+            }
+        }
+        return file;
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return nullptr;
+}
+
+void lane_file_close(lane_file* file) {
+    delete file;
+}
+
+size_t lane_file_channel_count(const lane_file* file) {
+    return file == nullptr ? 0 : file->channelIDs.size();
+}
+
+uint32_t lane_file_channel_id(const lane_file* file, size_t index) {
+    if (file == nullptr || index >= file->channelIDs.size()) {
+        return 0;
+    }
+    return file->channelIDs[index];
+}
+
+size_t lane_file_frame_count(const lane_file* file, uint32_t channel) {
+    auto found = findChannel(file, channel);
+    return found == nullptr ? 0 : found->frames.size();
+}
+
+const lane_frame_info* lane_file_frames(const lane_file* file, uint32_t channel) {
+    auto found = findChannel(file, channel);
+    return found == nullptr || found->frames.empty() ? nullptr : found->frames.data();
+}
+
+size_t lane_file_pixel_count(const lane_file* file, uint32_t channel) {
+    auto found = findChannel(file, channel);
+    return found == nullptr ? 0 : found->pixels.size();
+}
+
+const lane_pixel* lane_file_pixels(const lane_file* file, uint32_t channel) {
+    auto found = findChannel(file, channel);
+    return found == nullptr || found->pixels.empty() ? nullptr : found->pixels.data();
+}
+
+lane_reader* lane_reader_open(const char* path, uint32_t channel) {
+    try {
+        return new lane_reader(path, channel);
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return nullptr;
+}
+
+void lane_reader_close(lane_reader* reader) {
+    delete reader;
+}
+
+int lane_reader_next(
+    lane_reader* reader,
+    lane_frame_info* frame,
+    const lane_pixel** pixels
+) {
+    if (reader == nullptr) {
+        lastError = "No reader to read from";
+        return -1;
+    }
+    try {
+        if (!reader->reader.next(reader->frame)) {
+            return 0;
+        }
+        lane_frame_info info;
+        reader->pixels.clear();
+        addFrame(reader->frame, info, reader->pixels);
+        if (frame != nullptr) {
+            *frame = info;
+        }
+        if (pixels != nullptr) {
+            *pixels = reader->pixels.data();
+        }
+        return 1;
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return -1;
+}
+
+lane_events* lane_events_open(const char* path) {
+    try {
+        return new lane_events(path);
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return nullptr;
+}
+
+void lane_events_close(lane_events* events) {
+    delete events;
+}
+
+int lane_events_next(
+    lane_events* events,
+    lane_event_info* event,
+    const lane_frame_info** frames,
+    const lane_pixel** pixels
+) {
+    if (events == nullptr) {
+        lastError = "No events to read from";
+        return -1;
+    }
+    try {
+        if (!events->builder.next(events->event)) {
+            return 0;
+        }
+        events->frames.clear();
+        events->pixels.clear();
+        for (const auto& f : events->event.frames) {
+            lane_frame_info info;
+            addFrame(f, info, events->pixels);
+            events->frames.emplace_back(info);
+        }
+        if (event != nullptr) {
+            event->time_stamp = events->event.timeStamp;
+            event->time_stamp_sub = events->event.timeStampSub;
+            event->frame_count = static_cast<std::uint32_t>(events->frames.size());
+            event->pixel_count = static_cast<std::uint32_t>(events->pixels.size());
+        }
+        if (frames != nullptr) {
+            *frames = events->frames.data();
+        }
+        if (pixels != nullptr) {
+            *pixels = events->pixels.data();
+        }
+        return 1;
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return -1;
+}
+
+lane_query* lane_query_create(void) {
+    try {
+        return new lane_query;
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return nullptr;
+}
+
+void lane_query_free(lane_query* query) {
+    delete query;
+}
+
+int lane_query_select(lane_query* query, const char* column) {
+    if (query == nullptr || column == nullptr) {
+        lastError = "No query or column given";
+        return -1;
+    }
+    try {
+        query->columns.emplace_back(column);
+        query->query.select(query->columns);
+        return 0;
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return -1;
+}
+
+int lane_query_where(
+    lane_query* query,
+    const char* column,
+    double min,
+    double max
+) {
+    if (query == nullptr || column == nullptr) {
+        lastError = "No query or column given";
+        return -1;
+    }
+    try {
+        query->query.where(column, min, max);
+        return 0;
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return -1;
+}
+
+lane_result* lane_query_run(
+    const lane_query* query,
+    const char* const* paths,
+    size_t count
+) {
+    if (query == nullptr || (paths == nullptr && count != 0)) {
+        lastError = "No query or paths given";
+        return nullptr;
+    }
+    try {
+        auto result = new lane_result;
+        try {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (paths[i] == nullptr) {
+                    throw std::runtime_error("No path given for table " + std::to_string(i));
+                }
+                query->query.run(paths[i], result->result);
+            }
+        } catch (...) {
+            delete result;
+            throw;
+        }
+        // Give every selected column a row count even if nothing was read
+        if (count == 0) {
+            result->result.columns = query->columns;
+            result->result.values.resize(query->columns.size());
+        }
+        return result;
+    } catch (const std::exception& e) {
+        setError(e);
+    } catch (...) {
+        setUnknownError();
+    }
+    return nullptr;
+}
+
+void lane_result_free(lane_result* result) {
+    delete result;
+}
+
+size_t lane_result_row_count(const lane_result* result) {
+    return result == nullptr ? 0 : result->result.getRowCount();
+}
+
+size_t lane_result_column_count(const lane_result* result) {
+    return result == nullptr ? 0 : result->result.columns.size();
+}
+
+const char* lane_result_column_name(const lane_result* result, size_t column) {
+    if (result == nullptr || column >= result->result.columns.size()) {
+        return nullptr;
+    }
+    return result->result.columns[column].c_str();
+}
+
+const double* lane_result_column(const lane_result* result, size_t column) {
+    if (result == nullptr || column >= result->result.values.size()) {
+        return nullptr;
+    }
+    const auto& values = result->result.values[column];
+    return values.empty() ? nullptr : values.data();
+}
+
+uint64_t lane_result_blocks_scanned(const lane_result* result) {
+    return result == nullptr ? 0 : result->result.blocksScanned;
+}
+
+uint64_t lane_result_blocks_skipped(const lane_result* result) {
+    return result == nullptr ? 0 : result->result.blocksSkipped;
+}
+
+}
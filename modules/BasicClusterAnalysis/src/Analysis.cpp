@@ -0,0 +1,382 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Analysis.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief The per frame cluster analysis, and writing out what it finds
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include "Utils/Arena.hpp"
+#include "Utils/Config.hpp"
+#include "Blob.hpp"
+#include "BlobFinder.hpp"
+#include "Frame.hpp"
+#include "ClusterTable.hpp"
+#include "Histogram.hpp"
+#include "HotPixelDetector.hpp"
+#include "BasicClusterAnalysis.hpp"
+#include "ClusterBatch.hpp"
+#include "ClusterClassifier.hpp"
+#include "Analysis.hpp"
+
+namespace {
+
+// Converts a pixel count (TOT) value into the energy deposited in the pixel.
+// If it isn't calibrated (or I haven't implemented loading the values) 
+// then use "typical" values
+float getEnergy(const unsigned int x) noexcept {
+    // Typical (ish) values from the calibration
+    const float a = 2, b = 80, c = 250, t = -0.1; 
+    // TODO load actual values of a, b, c and t
+    if (x == 0) {
+        return 0;
+    }
+    return a * x + b + c / (x + t);
+}
+
+// The names of the fields, in the settings and the outputs
+const char* const fieldNames[fieldCount] = {
+    "Azimuth", "Polar", "Volume", "Height", "HittingArea", "TouchingEdge",
+    "LET", "Size", "X", "Y", "Class"
+};
+
+// Works out the set of fields from their names, with none meaning all
+FieldSet getFields(const std::vector<std::string>& names) {
+    FieldSet fields;
+    if (names.empty()) {
+        return fields.set();
+    }
+    for (const auto& name : names) {
+        auto found = std::find(fieldNames, fieldNames + fieldCount, name);
+        if (found == fieldNames + fieldCount) {
+            throw std::runtime_error("Unknown output field: " + name);
+        }
+        fields.set(found - fieldNames);
+    }
+    return fields;
+}
+
+// Writes out the chosen features of every cluster found in a frame
+void writeClusters(
+    std::ostream& outf,
+    const unsigned int frameNumber,
+    const lane::Frame& f,
+    const ClusterBatch& batch,
+    const std::vector<ClusterClass>& classes,
+    const FieldSet& fields
+) {
+    for (std::size_t i = 0; i < batch.getSize(); ++i) {
+        // Output the data in a simple way for now
+        outf << "Frame " << frameNumber << "\n";
+        outf << "TimeStamp " << f.getTimeStamp() << "." << f.getTimeStampSub() << "\n";
+        if (fields[AzimuthField]) {
+            outf << "Azimuth " << batch.azimuthAngle[i] << "\n";
+        }
+        if (fields[PolarField]) {
+            outf << "Polar " << batch.polarAngle[i] << "\n";
+        }
+        if (fields[VolumeField]) {
+            outf << "Volume " << batch.volume[i] << "\n";
+        }
+        if (fields[HeightField]) {
+            outf << "Height " << batch.height[i] << "\n";
+        }
+        if (fields[HittingAreaField]) {
+            outf << "HittingArea " << batch.hittingArea[i] << "\n";
+        }
+        if (fields[TouchingEdgeField]) {
+            outf << "TouchingEdge " << static_cast<bool>(batch.touchingEdge[i]) << "\n";
+        }
+        if (fields[LETField]) {
+            outf << "LET " << batch.LET[i] << "\n";
+        }
+        if (fields[SizeField]) {
+            outf << "Size " << batch.size[i] << "\n";
+        }
+        if (fields[XField]) {
+            outf << "X " << batch.xBar[i] << "\n";
+        }
+        if (fields[YField]) {
+            outf << "Y " << batch.yBar[i] << "\n";
+        }
+        if (fields[ClassField]) {
+            outf << "Class " << getClusterClassName(classes[i]) << "\n";
+        }
+        outf << "\n\n";
+    }
+}
+
+// Adds a row of the chosen features for every cluster found in a frame to a
+// cluster table
+void addTableRows(
+    lane::ClusterTableWriter& table,
+    const unsigned int channel,
+    const unsigned int frameNumber,
+    const lane::Frame& f,
+    const ClusterBatch& batch,
+    const std::vector<ClusterClass>& classes,
+    const FieldSet& fields
+) {
+    double row[4 + fieldCount];
+    row[0] = channel;
+    row[1] = frameNumber;
+    row[2] = f.getTimeStamp();
+    row[3] = f.getTimeStampSub();
+    for (std::size_t i = 0; i < batch.getSize(); ++i) {
+        const double values[fieldCount] = {
+            batch.azimuthAngle[i],
+            batch.polarAngle[i],
+            batch.volume[i],
+            batch.height[i],
+            static_cast<double>(batch.hittingArea[i]),
+            static_cast<double>(batch.touchingEdge[i]),
+            batch.LET[i],
+            static_cast<double>(batch.size[i]),
+            batch.xBar[i],
+            batch.yBar[i],
+            fields[ClassField] ? static_cast<double>(classes[i]) : 0.0
+        };
+        std::size_t column = 4;
+        for (std::size_t j = 0; j < fieldCount; ++j) {
+            if (fields[j]) {
+                row[column++] = values[j];
+            }
+        }
+        table.addRow(row);
+    }
+}
+
+// The standard spectra and distributions, in the order filled by fillSpectra
+enum Spectrum {
+    LETSpectrum = 0,
+    EnergySpectrum,
+    SizeDistribution,
+    PolarDistribution,
+    AzimuthDistribution
+};
+
+// Counts the features of every cluster found in a frame
+void fillSpectra(
+    std::vector<lane::Histogram>& spectra,
+    const ClusterBatch& batch
+) {
+    const auto count = batch.getSize();
+    spectra[LETSpectrum].fill(batch.LET.data(), count);
+    spectra[EnergySpectrum].fill(batch.volume.data(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        spectra[SizeDistribution].fill(batch.size[i]);
+    }
+    spectra[PolarDistribution].fill(batch.polarAngle.data(), count);
+    spectra[AzimuthDistribution].fill(batch.azimuthAngle.data(), count);
+}
+
+lane::HotPixelThresholds getHotPixelThresholds(const lane::utils::Config& config) {
+    lane::HotPixelThresholds thresholds;
+    thresholds.minFrames = config.getInteger(
+        "hotPixels", "minFrames", thresholds.minFrames
+    );
+    thresholds.maxHitFraction = config.getDouble(
+        "hotPixels", "maxHitFraction", thresholds.maxHitFraction
+    );
+    thresholds.maxMeanCount = config.getDouble(
+        "hotPixels", "maxMeanCount", thresholds.maxMeanCount
+    );
+    thresholds.minHitsForSpread = config.getInteger(
+        "hotPixels", "minHitsForSpread", thresholds.minHitsForSpread
+    );
+    thresholds.minCountStdDev = config.getDouble(
+        "hotPixels", "minCountStdDev", thresholds.minCountStdDev
+    );
+    return thresholds;
+}
+
+ClassifierCuts getClassifierCuts(const lane::utils::Config& config) {
+    ClassifierCuts cuts;
+    cuts.dotMaxSize = config.getInteger(
+        "classifier", "dotMaxSize", cuts.dotMaxSize
+    );
+    cuts.smallBlobMaxSize = config.getInteger(
+        "classifier", "smallBlobMaxSize", cuts.smallBlobMaxSize
+    );
+    cuts.blobMaxEccentricity = config.getDouble(
+        "classifier", "blobMaxEccentricity", cuts.blobMaxEccentricity
+    );
+    cuts.heavyMinHeight = config.getDouble(
+        "classifier", "heavyMinHeight", cuts.heavyMinHeight
+    );
+    cuts.straightMinEccentricity = config.getDouble(
+        "classifier", "straightMinEccentricity", cuts.straightMinEccentricity
+    );
+    return cuts;
+}
+
+}
+
+std::vector<std::string> getTableColumns(const FieldSet& fields) {
+    std::vector<std::string> columns = {
+        "Channel", "Frame", "TimeStamp", "TimeStampSub"
+    };
+    for (std::size_t i = 0; i < fieldCount; ++i) {
+        if (fields[i]) {
+            columns.emplace_back(fieldNames[i]);
+        }
+    }
+    return columns;
+}
+
+std::vector<lane::Histogram> createSpectra() {
+    using lane::Histogram;
+    const double pi = std::acos(-1.0);
+    std::vector<Histogram> spectra;
+    spectra.emplace_back("LET", 100, 0.01, 1000, Histogram::Binning::Logarithmic);
+    spectra.emplace_back("Energy", 100, 1, 1e6, Histogram::Binning::Logarithmic);
+    // One bin per cluster size
+    spectra.emplace_back("Size", 256, 0.5, 256.5);
+    // The angles can land exactly on the top of their ranges, [0, pi/2] for
+    // polar and (-pi/2, pi] for azimuth (which has pi/2 added when the
+    // track's major and minor axes are swapped), so the last bin is widened
+    // just enough to take them rather than them overflowing
+    spectra.emplace_back("Polar", 90, 0, std::nextafter(pi / 2, pi));
+    spectra.emplace_back("Azimuth", 270, -pi / 2, std::nextafter(pi, 2 * pi));
+    return spectra;
+}
+
+void writeClassCountsHeader(std::ostream& outf) {
+    outf << "File,Channel";
+    for (std::size_t c = 0; c < clusterClassCount; ++c) {
+        outf << "," << getClusterClassName(static_cast<ClusterClass>(c));
+    }
+    outf << "\n";
+}
+
+void writeClassCounts(
+    std::ostream& outf,
+    const std::string& fileName,
+    const unsigned int channel,
+    const ClusterClassCounts& counts
+) {
+    outf << fileName << "," << channel;
+    for (const auto count : counts) {
+        outf << "," << count;
+    }
+    outf << "\n";
+}
+
+Analysis::Analysis(const lane::utils::Config& config)
+: isFindingHotPixels(config.getBool("hotPixels", "enabled", false)),
+  hotPixelThresholds(getHotPixelThresholds(config)),
+  isSubtractingBackground(config.getBool("background", "enabled", false)),
+  background(
+      config.getDouble("background", "weight", 0.05),
+      config.getDouble("background", "minLevel", 1.0)
+  ),
+  droppedPixels(0),
+  repeatedFrames(0),
+  isWritingTable(config.getBool("output", "table", true)),
+  fields(getFields(config.getList("output", "fields"))),
+  isClassifying(fields[ClassField]),
+  cuts(getClassifierCuts(config)),
+  classifier(cuts),
+  isWritingSpectra(config.getBool("output", "spectra", true)) {
+    // Azimuth and the projected track length (which polar angle and LET are
+    // derived from) need the expensive geometric analysis of each cluster
+    FieldSet neededFields = fields;
+    if (isWritingSpectra) {
+        neededFields.set(LETField).set(VolumeField).set(SizeField)
+            .set(PolarField).set(AzimuthField);
+    }
+    isTracking = neededFields[AzimuthField] ||
+        neededFields[PolarField] || neededFields[LETField];
+    batchFeatures = 0;
+    if (neededFields[XField] || neededFields[YField]) {
+        batchFeatures |= ClusterBatch::CentroidFeatures;
+    }
+    if (neededFields[PolarField] || neededFields[LETField]) {
+        batchFeatures |= ClusterBatch::TrackFeatures;
+    }
+    if (neededFields[HittingAreaField] || neededFields[TouchingEdgeField]) {
+        batchFeatures |= ClusterBatch::AreaFeatures;
+    }
+}
+
+void Analysis::processFrame(const lane::Frame& input, ChannelOutput& output) {
+    arena.reset();
+    batch.clear();
+    if (isFindingHotPixels) {
+        hotPixels.addFrame(input);
+    }
+    if (isSubtractingBackground) {
+        droppedPixels += background.subtract(input, subtracted);
+    }
+    const lane::Frame& f = isSubtractingBackground ? subtracted : input;
+    for (auto& b : findBlobs(f, arena)) {
+        // Fill in the energies of the blob's pixels in place
+        auto& pixels = b.getPixels();
+        for (auto& p : pixels) {
+            p.setE(getEnergy(p.getC()));
+        }
+
+        // Only clusters of more than one pixel need the full geometric
+        // analysis, for the rest it's all zero. The classifier only looks at
+        // the shape of clusters too big to be small blobs
+        // TODO Set the appropriate bias voltage at some point
+        double azimuth = 0;
+        double projectedLength = 0;
+        double eccentricity = 0;
+        bool needsShape = isClassifying && pixels.size() > cuts.smallBlobMaxSize;
+        if (pixels.size() > 1 && (isTracking || needsShape)) {
+            Cluster cl(arena);
+            for (const auto& p : pixels) {
+                cl.addPixel(p);
+            }
+            if (isTracking) {
+                azimuth = cl.getAzimuthAngle();
+                projectedLength = cl.getProjectedTrackLength();
+            }
+            if (needsShape) {
+                eccentricity = cl.getEccentricity();
+            }
+        }
+        batch.addCluster(
+            pixels.data(),
+            pixels.size(),
+            azimuth,
+            projectedLength,
+            eccentricity
+        );
+    }
+
+    // Work out the remaining features for the whole frame
+    batch.computeFeatures(300, batchFeatures);
+    if (isClassifying) {
+        classifier.classify(batch, classes, output.classCounts);
+    }
+    if (output.bca) {
+        writeClusters(*output.bca, output.frameNumber, f, batch, classes, fields);
+    }
+    if (output.table) {
+        addTableRows(
+            *output.table, output.channel, output.frameNumber, f, batch,
+            classes, fields
+        );
+    }
+    if (output.spectra) {
+        fillSpectra(*output.spectra, batch);
+    }
+    ++output.frameNumber;
+}
@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Analysis.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief The per frame cluster analysis, and writing out what it finds
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef ANALYSIS_HPP
+#define ANALYSIS_HPP
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <bitset>
+#include <cstdint>
+#include "Utils/Arena.hpp"
+#include "Utils/Config.hpp"
+#include "Frame.hpp"
+#include "ClusterTable.hpp"
+#include "Histogram.hpp"
+#include "HotPixelDetector.hpp"
+#include "BackgroundModel.hpp"
+#include "ClusterBatch.hpp"
+#include "ClusterClassifier.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The features which can be written out for each cluster, in output
+/// order
+enum Field {
+    AzimuthField = 0,
+    PolarField,
+    VolumeField,
+    HeightField,
+    HittingAreaField,
+    TouchingEdgeField,
+    LETField,
+    SizeField,
+    XField,
+    YField,
+    ClassField,
+    fieldCount
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A set of the features written out for each cluster
+typedef std::bitset<fieldCount> FieldSet;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the columns of the cluster table written by the analysis
+/// \param fields The features written out for each cluster
+/// \return The names of the columns, in order
+std::vector<std::string> getTableColumns(const FieldSet& fields);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Creates the standard spectra and distributions filled by the
+/// analysis, all empty
+/// \return The LET and energy spectra, and the size, polar angle and azimuth
+/// distributions
+std::vector<lane::Histogram> createSpectra();
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes the header row of the cluster class counts file
+/// \param outf The stream to write to
+void writeClassCountsHeader(std::ostream& outf);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes the number of clusters of each class found in a channel of
+/// a file
+/// \param outf The stream to write to
+/// \param fileName The name of the file, to start the row with
+/// \param channel The channel
+/// \param counts The number of clusters of each class
+void writeClassCounts(
+    std::ostream& outf,
+    const std::string& fileName,
+    const unsigned int channel,
+    const ClusterClassCounts& counts
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Where the results of analysing the frames of a channel go. Each
+/// output is left null when not being written
+struct ChannelOutput {
+    /// The text output
+    std::ostream* bca = nullptr;
+    /// The cluster table
+    lane::ClusterTableWriter* table = nullptr;
+    /// The spectra, as made by createSpectra
+    std::vector<lane::Histogram>* spectra = nullptr;
+    /// The channel of the frames
+    unsigned int channel = 0;
+    /// The number of the next frame
+    unsigned int frameNumber = 1;
+    /// The number of clusters of each class found so far
+    ClusterClassCounts classCounts = {};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The analysis settings, along with what's kept from frame to frame
+struct Analysis {
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Throws a std::runtime_error if the settings are
+    /// malformed.
+    /// \param config The module settings
+    explicit Analysis(const lane::utils::Config& config);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Analyses a single frame and writes out its clusters
+    /// \param input The frame
+    /// \param output Where the clusters are written to
+    void processFrame(const lane::Frame& input, ChannelOutput& output);
+
+    /// Hot pixels are looked for alongside the analysis
+    bool isFindingHotPixels;
+    lane::HotPixelThresholds hotPixelThresholds;
+    lane::HotPixelDetector hotPixels;
+
+    /// A rolling per-pixel background can be taken off each frame before
+    /// looking for clusters, to stop long-lived noisy pixels being found
+    /// as clusters frame after frame
+    bool isSubtractingBackground;
+    lane::BackgroundModel background;
+    std::uint64_t droppedPixels;
+
+    /// Frames repeated in the input files (retransmitted or in overlapping
+    /// fragments) are dropped by the readers rather than analysed twice
+    std::uint64_t repeatedFrames;
+
+    /// A cluster table can be written alongside each text output file for
+    /// fast querying
+    bool isWritingTable;
+
+    /// Only the chosen features of each cluster are written out
+    FieldSet fields;
+
+    /// Clusters are classified by their shape, and counted by class, when
+    /// their class is written out
+    bool isClassifying;
+    ClassifierCuts cuts;
+    ClusterClassifier classifier;
+
+    /// Standard spectra are written out for each input file, and for all of
+    /// them together
+    bool isWritingSpectra;
+
+    /// Only the features needed by the fields written out or the spectra are
+    /// worked out
+    bool isTracking;
+    unsigned int batchFeatures;
+
+    lane::Frame subtracted;
+    std::vector<ClusterClass> classes;
+    /// The features of every cluster in the current frame
+    ClusterBatch batch;
+    /// Per-frame temporaries are drawn from here and freed in one go
+    lane::utils::Arena arena;
+};
+
+#endif // ANALYSIS_HPP
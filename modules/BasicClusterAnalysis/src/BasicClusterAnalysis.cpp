@@ -17,8 +17,10 @@
 #include <map>
 #include <cstdlib>
 #include <cmath>
+#include <algorithm>
 #include "Pixel.hpp"
 #include "BasicClusterAnalysis.hpp"
+#include "Utils/Arena.hpp"
 
 // DONE: Add support for getting min x/y and max x/y form clusters
 // Actually we only need to save if the cluster is touching the edge
@@ -44,7 +46,8 @@ lane::Pixel rotatePixel(const lane::Pixel& pixel, const double azimuthAngle) noe
 }
 
 Cluster::Cluster()
-: volume_(0),
+: arena_(nullptr),
+  volume_(0),
   height_(0),
   biasVoltage_(0),
   detectorThickness_(300),
@@ -52,6 +55,7 @@ Cluster::Cluster()
   polarAngle_(-1),
   majorLength_(-1),
   minorWidth_(-1),
+  eccentricity_(-1),
   projectedTrackLength_(-1),
   trackLength_(0),
   xmin_(255),
@@ -62,6 +66,12 @@ Cluster::Cluster()
   ybar_(-1)  {
 }
 
+Cluster::Cluster(lane::utils::Arena& arena)
+: Cluster() {
+    arena_ = &arena;
+    pixels_ = PixelList(PixelList::allocator_type(arena));
+}
+
 Cluster::~Cluster() noexcept {
     clear();
 }
@@ -87,6 +97,7 @@ bool Cluster::operator==(const Cluster& other) const noexcept {
             polarAngle_ == other.polarAngle_ &&
             majorLength_ == other.majorLength_ &&
             minorWidth_ == other.minorWidth_ &&
+            eccentricity_ == other.eccentricity_ &&
             projectedTrackLength_ == other.projectedTrackLength_ &&
             trackLength_ == other.trackLength_ &&
             xmin_ == other.xmin_ &&
@@ -111,6 +122,7 @@ void Cluster::clear() noexcept {
     polarAngle_ = -1;
     majorLength_ = -1;
     minorWidth_ = -1;
+    eccentricity_ = -1;
     projectedTrackLength_ = -1;
     trackLength_ = 0;
     xmin_ = 255;
@@ -159,7 +171,7 @@ unsigned int Cluster::getHittingArea() const noexcept {
     return (254 + xmin_ - xmax_) * (254 + ymin_ - ymax_);
 }
 
-const std::vector<lane::Pixel>& Cluster::getPixels() const noexcept {
+const Cluster::PixelList& Cluster::getPixels() const noexcept {
     return pixels_;
 }
 
@@ -285,13 +297,14 @@ double Cluster::getProjectedTrackLength() noexcept {
     double threshold = height_ / 20;
 
     double azimuth = getAzimuthAngle();
-    std::map<int, double> majorHis, minorHis;
-    std::map<int, double>::iterator p;
-    std::map<int, double> majorHiscc, minorHiscc;
+    EnergyHistogram::allocator_type allocator(arena_);
+    EnergyHistogram majorHis(allocator), minorHis(allocator);
+    EnergyHistogram::iterator p;
+    EnergyHistogram majorHiscc(allocator), minorHiscc(allocator);
     //the projected track is assumed to be parallel to X-axis if 0< |azimuthAngle| < 10 degree and parallel to Y-axis if 80 < |azimuthAngle| < 90 degree
 
     //need to rotate the coordinate
-    std::list<double> rotatedData;//list of triple<x,y,v>
+    std::list<double, lane::utils::ArenaAllocator<double>> rotatedData(allocator);//list of triple<x,y,v>
     for (auto iter = std::begin(pixels_); iter != std::end(pixels_); ++iter) {
         if (iter->getE() > threshold) {
             auto newPixel = rotatePixel(*iter, -azimuth);
@@ -389,6 +402,41 @@ double Cluster::getTrackLength() noexcept {
     return trackLength_;
 }
 
+double Cluster::getEccentricity() noexcept {
+    if (eccentricity_ >= 0) {
+        return eccentricity_;
+    }
+    eccentricity_ = 0;
+    if (getSize() <= 1) {
+        return eccentricity_;
+    }
+
+    double n = getSize();
+    double sx = 0, sy = 0;
+    for (const auto& pixel : pixels_) {
+        sx += pixel.getX();
+        sy += pixel.getY();
+    }
+    double mx = sx / n, my = sy / n;
+    double sxx = 0, syy = 0, sxy = 0;
+    for (const auto& pixel : pixels_) {
+        double dx = pixel.getX() - mx, dy = pixel.getY() - my;
+        sxx += dx * dx;
+        syy += dy * dy;
+        sxy += dx * dy;
+    }
+    // Eigenvalues of the covariance matrix give the spread along the
+    // major and minor axes
+    double mean = (sxx + syy) / (2 * n);
+    double diff = (sxx - syy) / (2 * n);
+    double root = std::sqrt(diff * diff + (sxy / n) * (sxy / n));
+    double major = mean + root, minor = mean - root;
+    if (major > 0) {
+        eccentricity_ = std::sqrt(std::max(0.0, 1 - minor / major));
+    }
+    return eccentricity_;
+}
+
 double Cluster::getPolarAngle() noexcept {
     if (polarAngle_ >= 0) {
         return polarAngle_;
@@ -404,10 +452,10 @@ double Cluster::getLETinSi() noexcept {
 }
 
 double Cluster::getFuzzyTrackLength(
-    std::map<int, double>& his,
+    EnergyHistogram& his,
     const double coeff
 ) noexcept {
-    std::map<int, double>::iterator iter = std::begin(his);
+    EnergyHistogram::iterator iter = std::begin(his);
     double arv = 0.0;
     double result = 0.0;
     for (; iter != std::end(his); ++iter) {
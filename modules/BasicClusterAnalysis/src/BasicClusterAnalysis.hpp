@@ -19,17 +19,40 @@
 #include <vector>
 #include <map>
 #include <cstdlib>
+#include <cstddef>
 #include <cmath>
 #include "LaneFile.hpp"
 #include "Pixel.hpp"
+#include "Utils/Arena.hpp"
+#include "Utils/SmallVector.hpp"
 
 
 class Cluster final {
 public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The number of pixels a cluster holds without allocating. Most
+    /// clusters are this size or smaller.
+    static const std::size_t inlinePixels = 4;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The container type used to store the cluster's pixels
+    typedef lane::utils::SmallVector<
+        lane::Pixel,
+        inlinePixels,
+        lane::utils::ArenaAllocator<lane::Pixel>
+    > PixelList;
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Constructor
     Cluster();
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. The cluster draws its pixel storage and all the
+    /// temporaries used in the analysis from the given arena, so it must not
+    /// outlive the arena's next reset.
+    /// \param arena The arena to allocate from
+    explicit Cluster(lane::utils::Arena& arena);
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Destructor
     ~Cluster() noexcept;
@@ -76,7 +99,7 @@ public:
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Retrieves a vector of the pixels currently in the cluster
     /// \return A vector of pixels in the cluster
-    const std::vector<lane::Pixel>& getPixels() const noexcept;
+    const PixelList& getPixels() const noexcept;
 
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Retrieves the size of the cluster in pixels
@@ -122,6 +145,13 @@ public:
     /// \return The track length
     double getTrackLength() noexcept;
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Calculates the eccentricity of the cluster's footprint from the
+    /// second moments of its pixel positions. 0 for round clusters, tending
+    /// to 1 for thin straight ones.
+    /// \return The eccentricity
+    double getEccentricity() noexcept;
+
     ///////////////////////////////////////////////////////////////////////////
     /// \brief Calculates the angle in radians with respect to the vertical
     /// direction
@@ -155,15 +185,26 @@ public:
     float getYBar() noexcept;
 
 private:
+    // Energy histogram type used when working out the track length
+    typedef std::map<
+        int,
+        double,
+        std::less<int>,
+        lane::utils::ArenaAllocator<std::pair<const int, double>>
+    > EnergyHistogram;
+
     // Caclulates the fuzzy track length of the cluster on the x-axis
     // (or y-axis) from its profile and a cut point (coeff)
     double getFuzzyTrackLength(
-        std::map<int, double>& energyHis,
+        EnergyHistogram& energyHis,
         const double coeff
     ) noexcept;
 
+    // The arena for temporaries (nullptr when using the heap)
+    lane::utils::Arena* arena_;
+
     // The storage for cluster pixels
-    std::vector<lane::Pixel> pixels_;
+    PixelList pixels_;
 
     // cluster parameters
     double volume_;
@@ -175,6 +216,7 @@ private:
     double polarAngle_;
     double majorLength_;
     double minorWidth_;
+    double eccentricity_;
     double projectedTrackLength_;
     double trackLength_;
     unsigned int xmin_;
@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ClusterBatch.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle. Based upon Son Hoang's code.
+/// \version 0.1
+///
+/// \brief Batch (structure-of-arrays) cluster feature extraction
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "Pixel.hpp"
+#include "ClusterBatch.hpp"
+
+void ClusterBatch::clear() noexcept {
+    size.clear();
+    volume.clear();
+    height.clear();
+    sumEX.clear();
+    sumEY.clear();
+    xMin.clear();
+    xMax.clear();
+    yMin.clear();
+    yMax.clear();
+    azimuthAngle.clear();
+    projectedTrackLength.clear();
+    eccentricity.clear();
+    xBar.clear();
+    yBar.clear();
+    trackLength.clear();
+    polarAngle.clear();
+    LET.clear();
+    hittingArea.clear();
+    touchingEdge.clear();
+}
+
+void ClusterBatch::reserve(const std::size_t n) {
+    size.reserve(n);
+    volume.reserve(n);
+    height.reserve(n);
+    sumEX.reserve(n);
+    sumEY.reserve(n);
+    xMin.reserve(n);
+    xMax.reserve(n);
+    yMin.reserve(n);
+    yMax.reserve(n);
+    azimuthAngle.reserve(n);
+    projectedTrackLength.reserve(n);
+    eccentricity.reserve(n);
+    xBar.reserve(n);
+    yBar.reserve(n);
+    trackLength.reserve(n);
+    polarAngle.reserve(n);
+    LET.reserve(n);
+    hittingArea.reserve(n);
+    touchingEdge.reserve(n);
+}
+
+std::size_t ClusterBatch::getSize() const noexcept {
+    return size.size();
+}
+
+void ClusterBatch::addCluster(
+    const lane::Pixel* pixels,
+    const std::size_t count,
+    const double azimuth,
+    const double projectedLength,
+    const double eccentricityValue
+) {
+    double v = 0, h = 0;
+    float wx = 0, wy = 0;
+    unsigned int x0 = 255, x1 = 0, y0 = 255, y1 = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto x = pixels[i].getX();
+        const auto y = pixels[i].getY();
+        const auto e = pixels[i].getE();
+        v += e;
+        wx += x * e;
+        wy += y * e;
+        h = e > h ? e : h;
+        x0 = x < x0 ? x : x0;
+        x1 = x > x1 ? x : x1;
+        y0 = y < y0 ? y : y0;
+        y1 = y > y1 ? y : y1;
+    }
+
+    size.emplace_back(count);
+    volume.emplace_back(v);
+    height.emplace_back(h);
+    sumEX.emplace_back(wx);
+    sumEY.emplace_back(wy);
+    xMin.emplace_back(x0);
+    xMax.emplace_back(x1);
+    yMin.emplace_back(y0);
+    yMax.emplace_back(y1);
+    azimuthAngle.emplace_back(azimuth);
+    projectedTrackLength.emplace_back(projectedLength);
+    eccentricity.emplace_back(eccentricityValue);
+}
+
+void ClusterBatch::computeFeatures(
+    const int detectorThickness,
+    const unsigned int features
+) noexcept {
+    const auto n = getSize();
+    xBar.resize(n);
+    yBar.resize(n);
+    trackLength.resize(n);
+    polarAngle.resize(n);
+    LET.resize(n);
+    hittingArea.resize(n);
+    touchingEdge.resize(n);
+
+    // Each feature gets its own loop over raw column pointers so that the
+    // compiler can vectorise them independently
+    const double thickness = detectorThickness;
+    const double thicknessSquared = detectorThickness * detectorThickness;
+    const double* ptl = projectedTrackLength.data();
+    const double* v = volume.data();
+    const float* wx = sumEX.data();
+    const float* wy = sumEY.data();
+    float* xb = xBar.data();
+    float* yb = yBar.data();
+    double* tl = trackLength.data();
+    double* polar = polarAngle.data();
+    double* let = LET.data();
+
+    if (features & CentroidFeatures) {
+        for (std::size_t i = 0; i < n; ++i) {
+            xb[i] = wx[i] / v[i];
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            yb[i] = wy[i] / v[i];
+        }
+    }
+    if (features & TrackFeatures) {
+        for (std::size_t i = 0; i < n; ++i) {
+            tl[i] = std::sqrt(ptl[i] * ptl[i] + thicknessSquared);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            let[i] = v[i] / tl[i];
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            polar[i] = std::atan(ptl[i] / thickness);
+        }
+    }
+    if (!(features & AreaFeatures)) {
+        return;
+    }
+
+    const unsigned int* x0 = xMin.data();
+    const unsigned int* x1 = xMax.data();
+    const unsigned int* y0 = yMin.data();
+    const unsigned int* y1 = yMax.data();
+    unsigned int* area = hittingArea.data();
+    std::uint8_t* edge = touchingEdge.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        const bool spansFrame = (x0[i] == 0 && x1[i] == 255) ||
+            (y0[i] == 0 && y1[i] == 255);
+        area[i] = spansFrame ? 0 :
+            (254 + x0[i] - x1[i]) * (254 + y0[i] - y1[i]);
+        edge[i] = x0[i] == 0 || y0[i] == 0 || x1[i] == 255 || y1[i] == 255;
+    }
+}
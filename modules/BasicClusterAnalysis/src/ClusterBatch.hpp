@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ClusterBatch.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle. Based upon Son Hoang's code.
+/// \version 0.1
+///
+/// \brief Batch (structure-of-arrays) cluster feature extraction
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef CLUSTERBATCH_HPP
+#define CLUSTERBATCH_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "Pixel.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Holds the moment sums and features of many clusters as columns
+/// (structure-of-arrays), so that the features can be worked out for the
+/// whole batch in tight, branch free loops which the compiler can vectorise.
+/// Row i of every column belongs to the i-th cluster added. The results
+/// match those of the per-cluster Cluster getters.
+struct ClusterBatch final {
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Removes all clusters from the batch, keeping the storage
+    void clear() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Reserves storage for a number of clusters
+    /// \param n The number of clusters to reserve storage for
+    void reserve(const std::size_t n);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of clusters in the batch
+    /// \return The number of clusters in the batch
+    std::size_t getSize() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a cluster's moment sums to the batch, in a single pass
+    /// over its pixels. The pixels must already have their energy set.
+    /// \param pixels The pixels of the cluster
+    /// \param count The number of pixels
+    /// \param azimuthAngle The azimuth angle of the cluster
+    /// \param projectedTrackLength The projected track length of the
+    /// cluster (0 for clusters of up to two pixels)
+    /// \param eccentricity The eccentricity of the cluster (0 for single
+    /// pixels)
+    void addCluster(
+        const lane::Pixel* pixels,
+        const std::size_t count,
+        const double azimuthAngle = 0.0,
+        const double projectedTrackLength = 0.0,
+        const double eccentricity = 0.0
+    );
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Groups of derived features, for choosing which computeFeatures
+    /// works out
+    enum Features : unsigned int {
+        /// xBar and yBar
+        CentroidFeatures = 1,
+        /// trackLength, polarAngle and LET
+        TrackFeatures = 2,
+        /// hittingArea and touchingEdge
+        AreaFeatures = 4,
+        AllFeatures = CentroidFeatures | TrackFeatures | AreaFeatures
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Works out the derived features (centroid, track length, polar
+    /// angle, LET, hitting area and edge contact) of every cluster from the
+    /// moment sums. The columns of features which aren't asked for are sized
+    /// to match, but left zero for the new clusters.
+    /// \param detectorThickness The thickness of the detector in micrometres
+    /// \param features The groups of features to work out (Features flags)
+    void computeFeatures(
+        const int detectorThickness = 300,
+        const unsigned int features = AllFeatures
+    ) noexcept;
+
+    // Moment sums and per-cluster inputs
+    std::vector<unsigned int> size;
+    std::vector<double> volume;
+    std::vector<double> height;
+    std::vector<float> sumEX;
+    std::vector<float> sumEY;
+    std::vector<unsigned int> xMin;
+    std::vector<unsigned int> xMax;
+    std::vector<unsigned int> yMin;
+    std::vector<unsigned int> yMax;
+    std::vector<double> azimuthAngle;
+    std::vector<double> projectedTrackLength;
+    std::vector<double> eccentricity;
+
+    // Derived features, filled in by computeFeatures
+    std::vector<float> xBar;
+    std::vector<float> yBar;
+    std::vector<double> trackLength;
+    std::vector<double> polarAngle;
+    std::vector<double> LET;
+    std::vector<unsigned int> hittingArea;
+    std::vector<std::uint8_t> touchingEdge;
+};
+
+#endif // CLUSTERBATCH_HPP
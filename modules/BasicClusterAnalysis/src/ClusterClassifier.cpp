@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ClusterClassifier.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Cut based classification of clusters by their morphology
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <vector>
+#include <cstddef>
+#include "ClusterClassifier.hpp"
+#include "ClusterBatch.hpp"
+
+const char* getClusterClassName(const ClusterClass clusterClass) noexcept {
+    switch (clusterClass) {
+    case ClusterClass::Dot:
+        return "Dot";
+    case ClusterClass::SmallBlob:
+        return "SmallBlob";
+    case ClusterClass::StraightTrack:
+        return "StraightTrack";
+    case ClusterClass::CurlyTrack:
+        return "CurlyTrack";
+    case ClusterClass::HeavyBlob:
+        return "HeavyBlob";
+    }
+    return "Unknown";
+}
+
+
+ClusterClassifier::ClusterClassifier(const ClassifierCuts& cuts) noexcept
+: cuts_(cuts) {
+}
+
+ClusterClassifier::~ClusterClassifier() noexcept = default;
+
+ClusterClassifier::ClusterClassifier(const ClusterClassifier& other) = default;
+
+ClusterClassifier::ClusterClassifier(ClusterClassifier&& other) = default;
+
+ClusterClassifier& ClusterClassifier::operator=(const ClusterClassifier& other) = default;
+
+ClusterClassifier& ClusterClassifier::operator=(ClusterClassifier&& other) = default;
+
+ClusterClass ClusterClassifier::classify(
+    const unsigned int size,
+    const double height,
+    const double eccentricity
+) const noexcept {
+    if (size <= cuts_.dotMaxSize) {
+        return ClusterClass::Dot;
+    }
+    if (size <= cuts_.smallBlobMaxSize) {
+        return ClusterClass::SmallBlob;
+    }
+    if (eccentricity <= cuts_.blobMaxEccentricity) {
+        return height >= cuts_.heavyMinHeight ?
+            ClusterClass::HeavyBlob :
+            ClusterClass::SmallBlob;
+    }
+    return eccentricity >= cuts_.straightMinEccentricity ?
+        ClusterClass::StraightTrack :
+        ClusterClass::CurlyTrack;
+}
+
+void ClusterClassifier::classify(
+    const ClusterBatch& batch,
+    std::vector<ClusterClass>& classes,
+    ClusterClassCounts& counts
+) const {
+    const auto n = batch.getSize();
+    classes.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        classes[i] = classify(
+            batch.size[i],
+            batch.height[i],
+            batch.eccentricity[i]
+        );
+        ++counts[static_cast<std::size_t>(classes[i])];
+    }
+}
+
+const ClassifierCuts& ClusterClassifier::getCuts() const noexcept {
+    return cuts_;
+}
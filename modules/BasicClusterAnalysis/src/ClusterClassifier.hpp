@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ClusterClassifier.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Cut based classification of clusters by their morphology
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef CLUSTERCLASSIFIER_HPP
+#define CLUSTERCLASSIFIER_HPP
+
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "ClusterBatch.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The morphological classes of clusters
+enum class ClusterClass : std::uint8_t {
+    Dot = 0,
+    SmallBlob,
+    StraightTrack,
+    CurlyTrack,
+    HeavyBlob
+};
+
+/// The number of cluster classes
+const std::size_t clusterClassCount = 5;
+
+/// A count of clusters for each class, indexed by class
+typedef std::array<std::uint64_t, clusterClassCount> ClusterClassCounts;
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the name of a cluster class
+/// \param clusterClass The class
+/// \return The name of the class
+const char* getClusterClassName(const ClusterClass clusterClass) noexcept;
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The cuts used to classify clusters
+struct ClassifierCuts {
+    /// Clusters of up to this many pixels are dots
+    unsigned int dotMaxSize = 2;
+    /// Otherwise, clusters of up to this many pixels are small blobs
+    unsigned int smallBlobMaxSize = 4;
+    /// Larger clusters at most this eccentric are blobs, and the rest tracks
+    double blobMaxEccentricity = 0.8;
+    /// Blobs whose most energetic pixel has at least this energy (keV) are
+    /// heavy blobs, the rest are small blobs
+    double heavyMinHeight = 700;
+    /// Tracks at least this eccentric are straight, the rest curly
+    double straightMinEccentricity = 0.95;
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Classifies clusters as dots, small blobs, straight tracks, curly
+/// tracks or heavy blobs by applying cuts to their features, in this order:
+/// size decides dots and small blobs, eccentricity then separates blobs from
+/// tracks, height separates heavy blobs from small ones, and eccentricity
+/// separates straight tracks from curly ones.
+class ClusterClassifier final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor
+    /// \param cuts The cuts to classify with
+    explicit ClusterClassifier(const ClassifierCuts& cuts = ClassifierCuts()) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~ClusterClassifier() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    ClusterClassifier(const ClusterClassifier& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    ClusterClassifier(ClusterClassifier&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    ClusterClassifier& operator=(const ClusterClassifier& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    ClusterClassifier& operator=(ClusterClassifier&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Classifies a single cluster
+    /// \param size The size of the cluster in pixels
+    /// \param height The energy of the cluster's most energetic pixel
+    /// \param eccentricity The eccentricity of the cluster
+    /// \return The class of the cluster
+    ClusterClass classify(
+        const unsigned int size,
+        const double height,
+        const double eccentricity
+    ) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Classifies every cluster in a batch, and counts them by class
+    /// \param batch The clusters to classify
+    /// \param classes The list to store the class of each cluster in
+    /// \param counts The counts to add the clusters to
+    void classify(
+        const ClusterBatch& batch,
+        std::vector<ClusterClass>& classes,
+        ClusterClassCounts& counts
+    ) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the cuts in use
+    /// \return The cuts in use
+    const ClassifierCuts& getCuts() const noexcept;
+
+private:
+    ClassifierCuts cuts_;
+};
+
+#endif // CLUSTERCLASSIFIER_HPP
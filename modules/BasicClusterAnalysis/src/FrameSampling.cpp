@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file FrameSampling.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Choosing samples of frames for quick look previews, and estimating
+/// per frame rates from them
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include "FrameSampling.hpp"
+
+namespace {
+
+// Parses a positive number, which must be the whole string
+double parsePositive(const std::string& text, const std::string& settings) {
+    char* end = nullptr;
+    const double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || *end != '\0' || !(value > 0)) {
+        throw std::runtime_error("Malformed preview sampling: " + settings);
+    }
+    return value;
+}
+
+}
+
+SamplingSettings parseSamplingSettings(const std::string& text) {
+    std::vector<std::string> parts;
+    std::string::size_type start = 0;
+    for (;;) {
+        const auto end = text.find(':', start);
+        parts.emplace_back(text.substr(start, end - start));
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+
+    SamplingSettings settings;
+    if (parts[0] == "every" && parts.size() == 2) {
+        settings.mode = SamplingMode::Every;
+    } else if (parts[0] == "random" && (parts.size() == 2 || parts.size() == 3)) {
+        settings.mode = SamplingMode::Random;
+    } else if (parts[0] == "time" && (parts.size() == 2 || parts.size() == 3)) {
+        settings.mode = SamplingMode::Time;
+    } else {
+        throw std::runtime_error("Malformed preview sampling: " + text);
+    }
+    settings.value = parsePositive(parts[1], text);
+    if (settings.mode != SamplingMode::Time &&
+        settings.value != std::floor(settings.value)
+    ) {
+        throw std::runtime_error("Malformed preview sampling: " + text);
+    }
+    if (parts.size() == 3) {
+        settings.seed = static_cast<std::uint32_t>(parsePositive(parts[2], text));
+    }
+    return settings;
+}
+
+std::vector<std::size_t> getSampleOrder(
+    const SamplingSettings& settings,
+    const std::size_t frameCount,
+    std::mt19937& random
+) {
+    std::vector<std::size_t> order;
+    if (settings.mode == SamplingMode::Every) {
+        const auto step = static_cast<std::size_t>(settings.value);
+        for (std::size_t i = 0; i < frameCount; i += step) {
+            order.push_back(i);
+        }
+        return order;
+    }
+
+    order.resize(frameCount);
+    std::iota(order.begin(), order.end(), 0);
+    if (settings.mode == SamplingMode::Time) {
+        std::shuffle(order.begin(), order.end(), random);
+        return order;
+    }
+
+    // Pick the first n of a partial shuffle, then put them back in file order
+    const auto n = std::min(frameCount, static_cast<std::size_t>(settings.value));
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uniform_int_distribution<std::size_t> pick(i, frameCount - 1);
+        std::swap(order[i], order[pick(random)]);
+    }
+    order.resize(n);
+    std::sort(order.begin(), order.end());
+    return order;
+}
+
+void SampleStatistics::add(const double value) noexcept {
+    // Welford's method, which stays accurate over many frames
+    ++count;
+    const double delta = value - mean;
+    mean += delta / count;
+    squares += delta * (value - mean);
+}
+
+double SampleStatistics::getMean() const noexcept {
+    return mean;
+}
+
+double SampleStatistics::getMeanError(const std::size_t frameCount) const noexcept {
+    if (count >= frameCount) {
+        return 0;
+    }
+    if (count < 2) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const double variance = squares / (count - 1);
+    const double correction = 1.0 - static_cast<double>(count) / frameCount;
+    return std::sqrt(variance / count * correction);
+}
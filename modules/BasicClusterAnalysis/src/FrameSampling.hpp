@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file FrameSampling.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Choosing samples of frames for quick look previews, and estimating
+/// per frame rates from them
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef FRAMESAMPLING_HPP
+#define FRAMESAMPLING_HPP
+
+#include <string>
+#include <vector>
+#include <random>
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief The ways of choosing which frames a preview analyses
+enum class SamplingMode : std::uint8_t {
+    /// Every Nth frame of each channel, starting with the first
+    Every = 0,
+    /// N frames of each channel picked at random
+    Random,
+    /// Frames picked at random, spread evenly over the channels, until a
+    /// time budget in seconds runs out
+    Time
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief How to sample the frames for a preview
+struct SamplingSettings {
+    SamplingMode mode = SamplingMode::Every;
+    /// N for the Every and Random modes, or the budget in seconds
+    double value = 1;
+    /// The seed for picking frames at random
+    std::uint32_t seed = 1;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Parses sampling settings of the form "every:N", "random:N[:SEED]"
+/// or "time:SECONDS[:SEED]". Throws a std::runtime_error if they're
+/// malformed.
+/// \param text The settings to parse
+/// \return The sampling settings
+SamplingSettings parseSamplingSettings(const std::string& text);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Chooses the frames of a channel to analyse, and the order to
+/// analyse them in. Every and Random samples are in frame order, so they can
+/// be read front to back, while Time samples are a random order of all the
+/// frames to be taken from until the time runs out.
+/// \param settings How to sample the frames
+/// \param frameCount The number of frames in the channel
+/// \param random The random number generator to pick frames with
+/// \return The positions of the frames to analyse
+std::vector<std::size_t> getSampleOrder(
+    const SamplingSettings& settings,
+    const std::size_t frameCount,
+    std::mt19937& random
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Running statistics of a per frame quantity over a sample of the
+/// frames, for estimating its mean and total over all the frames
+struct SampleStatistics {
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Adds the quantity for a sampled frame
+    /// \param value The quantity for the frame
+    void add(const double value) noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the mean over the sampled frames
+    /// \return The mean, or 0 if no frames have been sampled
+    double getMean() const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the standard error of the mean as an estimate of the mean
+    /// over all the frames, treating the sample as a simple random sample
+    /// taken without replacement (so the error falls to 0 as the sample takes
+    /// in every frame)
+    /// \param frameCount The number of frames sampled from
+    /// \return The standard error, which is NaN with fewer than two sampled
+    /// frames unless every frame was sampled
+    double getMeanError(const std::size_t frameCount) const noexcept;
+
+    /// The number of sampled frames
+    std::size_t count = 0;
+    /// The running mean
+    double mean = 0;
+    /// The running sum of squared differences from the mean
+    double squares = 0;
+};
+
+#endif // FRAMESAMPLING_HPP
@@ -15,92 +15,567 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <memory>
 #include <string>
 #include <vector>
+#include <map>
+#include <utility>
+#include <stdexcept>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
 #include "Utils/Filesystem.hpp"
-#include "Blob.hpp"
-#include "BlobFinder.hpp"
+#include "Utils/Config.hpp"
+#include "Utils/System.hpp"
+#include "Utils/ThreadPool.hpp"
 #include "Frame.hpp"
 #include "LaneFile.hpp"
-#include "BasicClusterAnalysis.hpp"
+#include "LaneFileReader.hpp"
+#include "LaneIndex.hpp"
+#include "ClusterTable.hpp"
+#include "Histogram.hpp"
+#include "HotPixelDetector.hpp"
+#include "ClusterClassifier.hpp"
+#include "FrameSampling.hpp"
+#include "ResultCache.hpp"
+#include "OutputShards.hpp"
+#include "Analysis.hpp"
+#include "OutputNames.hpp"
+#include "ResultCacheKey.hpp"
+#include "Watch.hpp"
+#include "Preview.hpp"
 
+namespace {
+
+// Calls a function on each frame of a channel of an input file in turn,
+// taking them from the loaded file if there is one, or otherwise streaming
+// them from the file one at a time, so only a frame is held at once.
+// Returns the number of repeated frames skipped while streaming (those of a
+// loaded file were dropped as it was loaded)
+template <typename Function>
+std::uint64_t forEachFrame(
+    const std::string& input,
+    const lane::LaneFile* file,
+    const lane::LaneIndex& index,
+    const unsigned int channel,
+    Function function
+) {
+    if (file) {
+        for (const auto& f : file->getFrames(channel)) {
+            function(f);
+        }
+        return 0;
+    }
+    lane::LaneFileReader reader(input, index, channel);
+    lane::Frame frame;
+    while (reader.next(frame)) {
+        function(frame);
+    }
+    return reader.getDuplicateFrameCount();
+}
+
+// A channel of an input file analysed into shards of its own, as a task on
+// the thread pool, with its own copy of the analysis state
+struct ShardedChannel {
+    explicit ShardedChannel(const lane::utils::Config& config)
+    : analysis(config),
+      spectra(createSpectra()),
+      classCounts() {
+    }
+
+    Analysis analysis;
+    std::vector<lane::Histogram> spectra;
+    ClusterClassCounts classCounts;
+    std::vector<ShardInfo> shards;
+};
+
+// Analyses the frames of a channel, writing its clusters to a shard per
+// channel or a shard per shardFrames frames in the output directory
+void analyseShards(
+    const std::string& input,
+    const lane::LaneFile* file,
+    const lane::LaneIndex& index,
+    const unsigned int channel,
+    const std::string& outputPath,
+    const std::string& stem,
+    const ShardLayout layout,
+    const unsigned int shardFrames,
+    ShardedChannel& sharded
+) {
+    auto& analysis = sharded.analysis;
+    ChannelOutput output;
+    output.channel = channel;
+    output.spectra = analysis.isWritingSpectra ? &sharded.spectra : nullptr;
+    std::ofstream outf;
+    std::unique_ptr<lane::ClusterTableWriter> table;
+
+    auto startShard = [&]() {
+        ShardInfo shard;
+        shard.fileName = getShardFileName(
+            stem, layout, channel, sharded.shards.size()
+        );
+        shard.channel = channel;
+        shard.firstFrame = output.frameNumber;
+        const auto path = outputPath + "/" + shard.fileName;
+        outf.open(path, std::fstream::out | std::fstream::binary);
+        if (!outf.is_open()) {
+            throw std::runtime_error("Unable to open file: " + path);
+        }
+        outf << "Channel " << channel << "\n";
+        output.bca = &outf;
+        if (analysis.isWritingTable) {
+            table.reset(new lane::ClusterTableWriter(
+                lane::utils::removeExtension(path) + ".lct",
+                getTableColumns(analysis.fields)
+            ));
+            output.table = table.get();
+        }
+        sharded.shards.emplace_back(std::move(shard));
+    };
+    auto finishShard = [&]() {
+        sharded.shards.back().frameCount =
+            output.frameNumber - sharded.shards.back().firstFrame;
+        outf.close();
+        if (!outf) {
+            throw std::runtime_error(
+                "Unable to write file: " + sharded.shards.back().fileName
+            );
+        }
+        outf.clear();
+        if (table) {
+            table->close();
+            table.reset();
+        }
+    };
+
+    startShard();
+    analysis.repeatedFrames += forEachFrame(
+        input, file, index, channel,
+        [&](const lane::Frame& f) {
+            if (
+                layout == ShardLayout::Frames &&
+                output.frameNumber - sharded.shards.back().firstFrame == shardFrames
+            ) {
+                finishShard();
+                startShard();
+            }
+            analysis.processFrame(f, output);
+        }
+    );
+    finishShard();
+    sharded.classCounts = output.classCounts;
+}
+
+// Shards are stored in the result cache named after this rather than the
+// input file, as the same input may have a different name next time
+const std::string cachedShardStem = "clusters";
+
+}
 
 int main(int argc, char *argv[]) {
     using namespace std;
     using namespace lane;
     using namespace lane::utils;
     
-    if (argc != 6) {
-        cout << "USAGE: " << argv[0] << " input-dir output-dir masks-dir calibrations-dir configurations-dir\n";
+    // Options come before the directories
+    int firstPath = 1;
+    bool isWatching = false;
+    string previewSampling;
+    while (firstPath < argc) {
+        string option = argv[firstPath];
+        if (option == "--watch") {
+            isWatching = true;
+            ++firstPath;
+        } else if (option == "--preview" && firstPath + 1 < argc) {
+            previewSampling = argv[firstPath + 1];
+            firstPath += 2;
+        } else {
+            break;
+        }
+    }
+    if (argc - firstPath != 5 || (isWatching && !previewSampling.empty())) {
+        cout << "USAGE: " << argv[0] << " [--watch | --preview SAMPLING] input-dir output-dir masks-dir calibrations-dir configurations-dir\n";
+        cout << "SAMPLING is every:N, random:N[:SEED] or time:SECONDS[:SEED]\n";
         return 1;
     }
     //TODO Load a, b, c and t calibration matrices here.
     
-    string inputPath = argv[1];
-    string outputPath = argv[2];
+    string inputPath = argv[firstPath];
+    string outputPath = argv[firstPath + 1];
+    string masksPath = argv[firstPath + 2];
+    string calibrationsPath = argv[firstPath + 3];
+    string configurationsPath = argv[firstPath + 4];
     
     
     try {
-        // Get the list of input file paths
-        auto inputs = getFilesWithExtension("lane", inputPath);
+        // Module settings, all of which are optional
+        Config config;
+        string configFile = configurationsPath + "/basicClusterAnalysis.ini";
+        if (fileExists(configFile)) {
+            config.read(configFile);
+        }
+        
+        // Everything run in parallel shares a pool of threads, which can be
+        // pinned to CPUs and spread over NUMA nodes
+        ThreadPoolSettings threadSettings;
+        threadSettings.threads = config.getInteger("threads", "workers", 0);
+        threadSettings.isPinning = config.getBool("threads", "pinning", false);
+        threadSettings.isNumaBinding = config.getBool("threads", "numa", false);
+        ThreadPool::configureShared(threadSettings);
+        
+        Analysis analysis(config);
+        
+        // Input files are only looked for in the input directory itself,
+        // unless its sub-directories are to be searched too
+        const bool isRecursive = config.getBool("input", "recursive", false);
+        
+        // In watch mode raw data files are analysed as they arrive, using
+        // the hot pixel masks from earlier runs rather than finding them
+        if (isWatching) {
+            analysis.isFindingHotPixels = false;
+            watch(inputPath, outputPath, masksPath, analysis);
+            return 0;
+        }
+        
+        // A preview analyses a sample of the frames, without writing out the
+        // clusters. The background can't be followed from frame to frame
+        if (!previewSampling.empty()) {
+            analysis.isFindingHotPixels = false;
+            analysis.isSubtractingBackground = false;
+            preview(
+                inputPath,
+                isRecursive,
+                outputPath,
+                parseSamplingSettings(previewSampling),
+                analysis
+            );
+            return 0;
+        }
+        
+        // Input files are parsed using this many of the pool's threads (0
+        // for all of them)
+        unsigned int readerThreads = config.getInteger("input", "readerThreads", 0);
+        if (readerThreads == 0) {
+            readerThreads = ThreadPool::getShared().getThreadCount();
+        }
+        
+        // Resident memory cap in megabytes (0 for no limit). With a cap, the
+        // input files are streamed through in windows of frames rather than
+        // loaded whole
+        uint64_t memoryBudget = config.getInteger("input", "memoryBudget", 0);
+        memoryBudget *= 1024 * 1024;
+        
+        // The clusters of each input file can be split into shards, a shard
+        // per channel or per shardFrames frames of each channel, with the
+        // channels analysed in parallel
+        auto shardLayout = parseShardLayout(
+            config.getString("output", "shards", "none")
+        );
+        auto shardFrames = static_cast<unsigned int>(
+            config.getInteger("output", "shardFrames", 10000)
+        );
+        if (shardLayout == ShardLayout::Frames && shardFrames == 0) {
+            throw runtime_error("The output shardFrames must be at least 1");
+        }
+        // The channels are analysed using this many of the pool's threads (0
+        // for all of them)
+        auto shardThreads = static_cast<unsigned int>(
+            config.getInteger("output", "shardThreads", 0)
+        );
+        
+        // The outputs of each input file can be kept in a cache, so that
+        // analysing the same file the same way again just links them into
+        // place
+        unique_ptr<ResultCache> cache;
+        uint64_t cacheKey = 0;
+        string cacheDirectory = config.getString("cache", "directory", "");
+        if (!cacheDirectory.empty()) {
+            cache.reset(new ResultCache(cacheDirectory));
+            cacheKey = getResultCacheKey(analysis, config, calibrationsPath);
+        }
+        
+        ofstream classCountsFile;
+        if (analysis.isClassifying) {
+            classCountsFile.open(outputPath + "/classes.csv");
+            writeClassCountsHeader(classCountsFile);
+        }
+        
+        vector<Histogram> totalSpectra;
+        // Each file's hot pixel statistics are gathered on their own, so they
+        // can be cached, then added to those of all the files
+        HotPixelDetector totalHotPixels;
+        
+        // Get the list of input files, and start with the largest so the
+        // longest work isn't left until last
+        auto inputs = walkDirectory(inputPath, "lane", isRecursive);
+        sortLargestFirst(inputs);
+        // Files in different sub-directories mustn't write over each other's
+        // outputs
+        map<string, string> outputStems;
+        for (const auto& inputFile : inputs) {
+            auto stem = getOutputStem(inputPath, inputFile.path);
+            auto found = outputStems.find(stem);
+            if (found != outputStems.end()) {
+                throw runtime_error(
+                    "Input files '" + found->second + "' and '" +
+                    inputFile.path + "' would both be written to '" +
+                    outputPath + "/" + stem + "'"
+                );
+            }
+            outputStems[stem] = inputFile.path;
+        }
         // Iterate over the input files
-        for (const auto& input : inputs) {
+        for (const auto& inputFile : inputs) {
+            const auto& input = inputFile.path;
+            const auto inputName = getRelativePath(inputPath, input);
             cout << "Running BCA on '" << input << "'";
-            auto file = LaneFile(input);
-            ofstream outf;
-            vector<Cluster> clusters;
+            auto outputName = outputPath + "/" + getOutputStem(inputPath, input);
             
-            outf.open(
-                outputPath + "/" + removeExtension(getFileName(input)) + ".bca",
-                fstream::out | fstream::binary
-            );
+            // Outputs may be hard links to files in the cache, so they're
+            // always removed rather than written over, along with the shards
+            // of any earlier run
+            remove((outputName + ".bca").c_str());
+            remove((outputName + ".lct").c_str());
+            remove((outputName + ".hist").c_str());
+            removeShards(outputName + ".bcm");
             
-            for (unsigned int channel = 0; channel < 5; ++channel) {
-                cout << ".";
-                outf << "Channel " << channel << "\n";
-                unsigned int frameNumber = 1;
-                for (const auto& f : file.getFrames(channel)) {
-                    for (const auto& b : findBlobs(f)) {
-                        Cluster cl;
-                        // Iterate over the keys in the blob
-                        // TODO Set the appropriate bias voltage at some point
-                        for (const auto k : b) {
-                            Pixel p = f.getPixel(k);
-                            // If it isn't calibrated (or I haven't implemented loading the values) 
-                            // then use "typical" values
-                            unsigned int x = p.getC();
-                            // Typical (ish) values from the calibration
-                            float a = 2, b = 80, c = 250, t = -0.1; 
-                            // TODO load actual values of a, b, c and t
-                            if (x == 0) {
-                                p.setE(0);
-                            } else {
-                                p.setE(a * x + b + c / (x + t));
-                                cl.addPixel(p);
-                            }
+            uint64_t key = 0;
+            if (cache) {
+                key = getInputCacheKey(cacheKey, input);
+            }
+            if (cache && cache->has(key)) {
+                cout << " cached\n";
+                if (shardLayout == ShardLayout::None) {
+                    linkFile(cache->getFilePath(key, "clusters.bca"), outputName + ".bca");
+                    if (analysis.isWritingTable) {
+                        linkFile(cache->getFilePath(key, "clusters.lct"), outputName + ".lct");
+                    }
+                } else {
+                    auto shards = readShardManifest(cache->getFilePath(key, "clusters.bcm"));
+                    for (auto& shard : shards) {
+                        auto cached = removeExtension(shard.fileName);
+                        shard.fileName = getFileName(outputName) +
+                            shard.fileName.substr(cachedShardStem.size());
+                        auto shardName = outputPath + "/" + removeExtension(shard.fileName);
+                        linkFile(cache->getFilePath(key, cached + ".bca"), shardName + ".bca");
+                        if (analysis.isWritingTable) {
+                            linkFile(cache->getFilePath(key, cached + ".lct"), shardName + ".lct");
                         }
-                        
-                        // Output the data in a simple way for now
-                        outf << "Frame " << frameNumber << "\n";
-                        outf << "TimeStamp " << f.getTimeStamp() << "." << f.getTimeStampSub() << "\n";
-                        outf << "Azimuth " << cl.getAzimuthAngle() << "\n";
-                        outf << "Polar " << cl.getPolarAngle() << "\n";
-                        outf << "Volume " << cl.getVolume() << "\n";
-                        outf << "Height " << cl.getHeight() << "\n";
-                        outf << "HittingArea " << cl.getHittingArea() << "\n";
-                        outf << "TouchingEdge " << cl.touchingEdge() << "\n";
-                        outf << "LET " << cl.getLETinSi() << "\n";
-                        outf << "Size " << cl.getSize() << "\n";
-                        outf << "X " << cl.getXBar() << "\n";
-                        outf << "Y " << cl.getYBar() << "\n\n\n";
                     }
+                    writeShardManifest(outputName + ".bcm", shards);
+                }
+                if (analysis.isWritingSpectra) {
+                    linkFile(cache->getFilePath(key, "spectra.hist"), outputName + ".hist");
+                    mergeHistograms(totalSpectra, readHistograms(outputName + ".hist"));
+                }
+                if (analysis.isClassifying) {
+                    // The rows are stored without the name of the file
+                    ifstream rows(cache->getFilePath(key, "classes.csv"));
+                    string row;
+                    while (getline(rows, row)) {
+                        classCountsFile << inputName << row << "\n";
+                    }
+                }
+                if (analysis.isFindingHotPixels) {
+                    analysis.hotPixels.read(cache->getFilePath(key, "hotPixels"));
+                    totalHotPixels.merge(analysis.hotPixels);
+                }
+                if (analysis.isSubtractingBackground) {
+                    ifstream dropped(cache->getFilePath(key, "droppedPixels"));
+                    uint64_t droppedPixels = 0;
+                    dropped >> droppedPixels;
+                    analysis.droppedPixels += droppedPixels;
+                }
+                ifstream repeated(cache->getFilePath(key, "repeatedFrames"));
+                uint64_t repeatedFrames = 0;
+                repeated >> repeatedFrames;
+                analysis.repeatedFrames += repeatedFrames;
+                continue;
+            }
+            
+            // Input files aren't taken in time order, so each starts afresh
+            analysis.background.clear();
+            analysis.hotPixels = HotPixelDetector();
+            const auto droppedPixels = analysis.droppedPixels;
+            const auto repeatedFrames = analysis.repeatedFrames;
+            // Load the whole file, unless memory is limited in which case
+            // only its index is loaded and the frames are streamed
+            unique_ptr<LaneFile> file;
+            LaneIndex index;
+            if (memoryBudget == 0) {
+                file.reset(new LaneFile(input, readerThreads));
+                analysis.repeatedFrames += file->getDuplicateFrameCount();
+            } else {
+                index = LaneIndex::load(input);
+            }
+            auto spectra = createSpectra();
+            ostringstream classCounts;
+            vector<ShardInfo> shards;
+            
+            if (shardLayout == ShardLayout::None) {
+                ofstream outf;
+                
+                outf.open(
+                    outputName + ".bca",
+                    fstream::out | fstream::binary
+                );
+                unique_ptr<ClusterTableWriter> table;
+                if (analysis.isWritingTable) {
+                    table.reset(new ClusterTableWriter(
+                        outputName + ".lct",
+                        getTableColumns(analysis.fields)
+                    ));
+                }
+                
+                for (unsigned int channel = 0; channel < 5; ++channel) {
+                    cout << ".";
+                    outf << "Channel " << channel << "\n";
+                    ChannelOutput output;
+                    output.bca = &outf;
+                    output.table = table.get();
+                    output.spectra = analysis.isWritingSpectra ? &spectra : nullptr;
+                    output.channel = channel;
                     
-                    ++frameNumber;
+                    analysis.repeatedFrames += forEachFrame(
+                        input, file.get(), index, channel,
+                        [&](const Frame& f) {
+                            analysis.processFrame(f, output);
+                        }
+                    );
+                    if (analysis.isClassifying) {
+                        writeClassCounts(classCounts, "", channel, output.classCounts);
+                    }
+                }
+                outf.close();
+                if (table) {
+                    table->close();
+                }
+            } else {
+                // Each channel is analysed as a task on the pool, which
+                // writes its shards, and the results are then gathered in
+                // channel order so they're the same as when not sharding.
+                // The state of each channel is made by its task, so it's
+                // allocated on the node of the thread using it
+                vector<unique_ptr<ShardedChannel>> channels(5);
+                const auto stem = getFileName(outputName);
+                ThreadPool::getShared().parallelFor(5, [&](const size_t channel) {
+                    channels[channel].reset(new ShardedChannel(config));
+                    analyseShards(
+                        input, file.get(), index,
+                        static_cast<unsigned int>(channel),
+                        outputPath, stem, shardLayout, shardFrames,
+                        *channels[channel]
+                    );
+                }, shardThreads);
+                for (unsigned int channel = 0; channel < 5; ++channel) {
+                    cout << ".";
+                    auto& sharded = *channels[channel];
+                    mergeHistograms(spectra, sharded.spectra);
+                    if (analysis.isClassifying) {
+                        writeClassCounts(classCounts, "", channel, sharded.classCounts);
+                    }
+                    analysis.hotPixels.merge(sharded.analysis.hotPixels);
+                    analysis.droppedPixels += sharded.analysis.droppedPixels;
+                    analysis.repeatedFrames += sharded.analysis.repeatedFrames;
+                    shards.insert(
+                        shards.end(),
+                        sharded.shards.begin(),
+                        sharded.shards.end()
+                    );
+                }
+                writeShardManifest(outputName + ".bcm", shards);
+            }
+            if (analysis.isClassifying) {
+                istringstream rows(classCounts.str());
+                string row;
+                while (getline(rows, row)) {
+                    classCountsFile << inputName << row << "\n";
                 }
             }
+            if (analysis.isWritingSpectra) {
+                writeHistograms(outputName + ".hist", spectra);
+                mergeHistograms(totalSpectra, spectra);
+            }
+            if (analysis.isFindingHotPixels) {
+                totalHotPixels.merge(analysis.hotPixels);
+            }
+            
+            if (cache) {
+                auto staging = cache->startEntry(key);
+                if (shardLayout == ShardLayout::None) {
+                    linkFile(outputName + ".bca", staging + "/clusters.bca");
+                    if (analysis.isWritingTable) {
+                        linkFile(outputName + ".lct", staging + "/clusters.lct");
+                    }
+                } else {
+                    auto cachedShards = shards;
+                    for (auto& shard : cachedShards) {
+                        const auto shardName = outputPath + "/" + removeExtension(shard.fileName);
+                        shard.fileName = cachedShardStem +
+                            shard.fileName.substr(getFileName(outputName).size());
+                        const auto cached = staging + "/" + removeExtension(shard.fileName);
+                        linkFile(shardName + ".bca", cached + ".bca");
+                        if (analysis.isWritingTable) {
+                            linkFile(shardName + ".lct", cached + ".lct");
+                        }
+                    }
+                    writeShardManifest(staging + "/clusters.bcm", cachedShards);
+                }
+                if (analysis.isWritingSpectra) {
+                    linkFile(outputName + ".hist", staging + "/spectra.hist");
+                }
+                if (analysis.isClassifying) {
+                    ofstream(staging + "/classes.csv") << classCounts.str();
+                }
+                if (analysis.isFindingHotPixels) {
+                    analysis.hotPixels.write(staging + "/hotPixels");
+                }
+                if (analysis.isSubtractingBackground) {
+                    ofstream(staging + "/droppedPixels")
+                        << analysis.droppedPixels - droppedPixels << "\n";
+                }
+                ofstream(staging + "/repeatedFrames")
+                    << analysis.repeatedFrames - repeatedFrames << "\n";
+                cache->finishEntry(key, staging);
+            }
             cout << "\n";
         }
+        
+        if (analysis.isWritingSpectra && !totalSpectra.empty()) {
+            writeHistograms(outputPath + "/spectra.hist", totalSpectra);
+            writeHistogramsCsv(outputPath + "/spectra.csv", totalSpectra);
+        }
+        
+        // Write out masks of the hot pixels found over all the inputs, over
+        // any masks the capture already has
+        if (analysis.isFindingHotPixels) {
+            auto captureName = getCaptureName(inputPath);
+            for (const auto channel : totalHotPixels.getChannelIDs()) {
+                auto mask = totalHotPixels.getHotPixels(
+                    channel, analysis.hotPixelThresholds
+                );
+                cout << "Found " << mask.getMaskedCount()
+                    << " hot pixels on channel " << channel << "\n";
+                mask.write(getMaskFileName(masksPath, captureName, channel));
+            }
+        }
+        
+        if (analysis.isSubtractingBackground) {
+            cout << "Background subtraction removed " << analysis.droppedPixels
+                << " pixels\n";
+        }
+        if (analysis.repeatedFrames != 0) {
+            cout << "Dropped " << analysis.repeatedFrames
+                << " repeated frames\n";
+        }
+        
+        auto peakMemory = getPeakResidentMemory();
+        cout << "Peak memory usage: " << peakMemory / (1024 * 1024) << " MB\n";
+        if (memoryBudget != 0 && peakMemory > memoryBudget) {
+            cout << "Warning: the memory budget of " << memoryBudget / (1024 * 1024)
+                << " MB was exceeded\n";
+        }
     } catch (const std::runtime_error& e) {
         cout << "\nAn error occurred.\n" << e.what() << "\n";
     } catch (const std::exception& e) {
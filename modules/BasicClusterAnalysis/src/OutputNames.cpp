@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file OutputNames.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Naming the outputs and hot pixel masks of input files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <algorithm>
+#include "Utils/Filesystem.hpp"
+#include "OutputNames.hpp"
+
+namespace {
+
+// Gets the name of the last directory in a path, ignoring trailing separators
+std::string getDirectoryName(std::string path) {
+    while (path.size() > 1 && (path.back() == '/' || path.back() == '\\')) {
+        path.pop_back();
+    }
+    return lane::utils::getFileName(path);
+}
+
+}
+
+std::string getCaptureName(const std::string& directory) {
+    return getDirectoryName(directory);
+}
+
+std::string getMaskFileName(
+    const std::string& masksPath,
+    const std::string& captureName,
+    const unsigned int channel
+) {
+    return masksPath + "/" + captureName + "_channel" + std::to_string(channel) +
+        ".mask";
+}
+
+std::string getRelativePath(const std::string& directory, const std::string& path) {
+    auto relative = path.substr(directory.size());
+    relative.erase(0, relative.find_first_not_of("/\\"));
+    return relative;
+}
+
+std::string getOutputStem(const std::string& inputPath, const std::string& input) {
+    auto stem = lane::utils::removeExtension(getRelativePath(inputPath, input));
+    std::replace(stem.begin(), stem.end(), '/', '_');
+    std::replace(stem.begin(), stem.end(), '\\', '_');
+    return stem;
+}
+
+std::string getWatchOutputName(const std::string& root, const std::string& file) {
+    auto directory = lane::utils::getPath(file);
+    if (directory.size() <= root.size()) {
+        return getDirectoryName(root);
+    }
+    auto name = directory.substr(root.size() + 1);
+    std::replace(name.begin(), name.end(), '/', '_');
+    std::replace(name.begin(), name.end(), '\\', '_');
+    return name;
+}
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file OutputNames.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Naming the outputs and hot pixel masks of input files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef OUTPUTNAMES_HPP
+#define OUTPUTNAMES_HPP
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the name of the capture whose data files are in a directory.
+/// Captures are named after the directory holding their files, as runLane.py
+/// runs the module on each directory of the data tree in turn, so that batch
+/// runs and watch mode agree on the names of the hot pixel masks
+/// \param directory The directory holding the capture's files
+/// \return The name of the capture
+std::string getCaptureName(const std::string& directory);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the path of the hot pixel mask of a channel of a capture,
+/// which is CAPTURE_channelN.mask in the masks directory
+/// \param masksPath The masks directory
+/// \param captureName The name of the capture
+/// \param channel The channel
+/// \return The path of the mask
+std::string getMaskFileName(
+    const std::string& masksPath,
+    const std::string& captureName,
+    const unsigned int channel
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the path of a file found under a directory relative to it
+/// \param directory The directory the file was found under
+/// \param path The path of the file
+/// \return The path of the file relative to the directory
+std::string getRelativePath(const std::string& directory, const std::string& path);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the name the outputs of an input file are written under, from
+/// its path relative to the input directory without the extension, so that
+/// input/a/x.lane gives a_x. Files straight in the input directory keep their
+/// own names
+/// \param inputPath The input directory
+/// \param input The path of the input file
+/// \return The name of the outputs, without an extension
+std::string getOutputStem(const std::string& inputPath, const std::string& input);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the name the outputs of a raw data file's capture are written
+/// under in watch mode, from the directories between the watched directory
+/// and the file, so that DATE/ID/file.ldat is written to DATE_ID.bca. Files
+/// straight in the watched directory are written under its name
+/// \param root The watched directory
+/// \param file The path of the raw data file
+/// \return The name of the outputs, without an extension
+std::string getWatchOutputName(const std::string& root, const std::string& file);
+
+#endif // OUTPUTNAMES_HPP
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file OutputShards.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Splitting the cluster output of an input file into shards, tied
+/// together by a manifest
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+#include "Utils/Filesystem.hpp"
+#include "OutputShards.hpp"
+
+namespace {
+
+const char manifestHeader[] = "File,Channel,FirstFrame,Frames";
+
+}
+
+ShardLayout parseShardLayout(const std::string& name) {
+    if (name == "none") {
+        return ShardLayout::None;
+    } else if (name == "channel") {
+        return ShardLayout::Channel;
+    } else if (name == "frames") {
+        return ShardLayout::Frames;
+    }
+    throw std::runtime_error("Unknown output shard layout: " + name);
+}
+
+std::string getShardFileName(
+    const std::string& stem,
+    const ShardLayout layout,
+    const unsigned int channel,
+    const unsigned int part
+) {
+    auto name = stem + "_channel" + std::to_string(channel);
+    if (layout == ShardLayout::Frames) {
+        name += "_part" + std::to_string(part);
+    }
+    return name + ".bca";
+}
+
+void writeShardManifest(
+    const std::string& fileName,
+    const std::vector<ShardInfo>& shards
+) {
+    std::ofstream output(
+        fileName,
+        std::ios::trunc | std::ios::binary | std::ios::out
+    );
+    if (!output.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    output << manifestHeader << "\n";
+    for (const auto& shard : shards) {
+        output << shard.fileName << "," << shard.channel << ","
+            << shard.firstFrame << "," << shard.frameCount << "\n";
+    }
+    if (!output) {
+        throw std::runtime_error("Unable to write file: " + fileName);
+    }
+}
+
+std::vector<ShardInfo> readShardManifest(const std::string& fileName) {
+    std::ifstream input(fileName, std::ios::in);
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    std::string line;
+    if (!std::getline(input, line) || line != manifestHeader) {
+        throw std::runtime_error("Not a valid BCA shard manifest: " + fileName);
+    }
+    std::vector<ShardInfo> shards;
+    while (std::getline(input, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        // The file name is everything before the last three fields
+        ShardInfo shard;
+        std::string::size_type end = line.size();
+        unsigned int* fields[] = {
+            &shard.frameCount, &shard.firstFrame, &shard.channel
+        };
+        for (auto field : fields) {
+            auto separator = line.rfind(',', end - 1);
+            if (separator == std::string::npos || separator == 0) {
+                throw std::runtime_error("Malformed BCA shard manifest: " + fileName);
+            }
+            std::istringstream value(line.substr(separator + 1, end - separator - 1));
+            if (!(value >> *field)) {
+                throw std::runtime_error("Malformed BCA shard manifest: " + fileName);
+            }
+            end = separator;
+        }
+        shard.fileName = line.substr(0, end);
+        shards.emplace_back(std::move(shard));
+    }
+    return shards;
+}
+
+void removeShards(const std::string& fileName) noexcept {
+    try {
+        if (!lane::utils::fileExists(fileName)) {
+            return;
+        }
+        const auto directory = lane::utils::getPath(fileName);
+        for (const auto& shard : readShardManifest(fileName)) {
+            const auto path = directory + "/" + shard.fileName;
+            std::remove(path.c_str());
+            std::remove((lane::utils::removeExtension(path) + ".lct").c_str());
+        }
+    } catch (...) {
+        // Leave the shards of a malformed manifest alone
+    }
+    std::remove(fileName.c_str());
+}
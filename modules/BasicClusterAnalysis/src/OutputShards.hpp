@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file OutputShards.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Splitting the cluster output of an input file into shards, tied
+/// together by a manifest
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef OUTPUTSHARDS_HPP
+#define OUTPUTSHARDS_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief How the cluster output of an input file is laid out
+enum class ShardLayout : std::uint8_t {
+    /// A single .bca file (and .lct table) for all the channels
+    None = 0,
+    /// A shard per channel
+    Channel,
+    /// A shard per fixed number of frames of each channel
+    Frames
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Parses the name of a shard layout ("none", "channel" or "frames").
+/// Throws a std::runtime_error if it isn't one.
+/// \param name The name of the layout
+/// \return The layout
+ShardLayout parseShardLayout(const std::string& name);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief A shard of the cluster output of an input file. Each shard is a
+/// .bca file in its own right, starting with the Channel line of the frames
+/// in it, with a cluster table of the same name if tables are written
+struct ShardInfo {
+    /// The name of the shard's .bca file, in the same directory as the
+    /// manifest
+    std::string fileName;
+    /// The channel of the frames in the shard
+    unsigned int channel = 0;
+    /// The number of the first frame in the shard
+    unsigned int firstFrame = 1;
+    /// The number of frames in the shard
+    unsigned int frameCount = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the name of a shard's .bca file, which is STEM_channelC.bca
+/// for a shard per channel and STEM_channelC_partP.bca for a shard per
+/// number of frames
+/// \param stem The output name of the input file, without its extension
+/// \param layout How the output is laid out
+/// \param channel The channel of the frames in the shard
+/// \param part The number of the shard within the channel, from 0
+/// \return The name of the shard's .bca file
+std::string getShardFileName(
+    const std::string& stem,
+    const ShardLayout layout,
+    const unsigned int channel,
+    const unsigned int part
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Writes the manifest of the shards of an input file's output, a CSV
+/// file with a row per shard in channel then frame order, so that reading
+/// the shards in turn gives every frame of the input file.
+/// Throws a std::runtime_error if it can't be written.
+/// \param fileName The name/path of the manifest (by convention STEM.bcm)
+/// \param shards The shards
+void writeShardManifest(
+    const std::string& fileName,
+    const std::vector<ShardInfo>& shards
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Reads a manifest written by writeShardManifest.
+/// Throws a std::runtime_error if it can't be read or is malformed.
+/// \param fileName The name/path of the manifest
+/// \return The shards, with their file names as written in the manifest
+std::vector<ShardInfo> readShardManifest(const std::string& fileName);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Removes a manifest along with the shards (and their cluster
+/// tables) it lists, if there is one
+/// \param fileName The name/path of the manifest
+void removeShards(const std::string& fileName) noexcept;
+
+#endif // OUTPUTSHARDS_HPP
@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Preview.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Quick look previews of input files from samples of their frames
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include "Utils/Filesystem.hpp"
+#include "Frame.hpp"
+#include "LaneFileReader.hpp"
+#include "LaneIndex.hpp"
+#include "Histogram.hpp"
+#include "ClusterClassifier.hpp"
+#include "FrameSampling.hpp"
+#include "Analysis.hpp"
+#include "OutputNames.hpp"
+#include "Preview.hpp"
+
+namespace {
+
+// A channel of an input file being sampled for a preview
+struct PreviewChannel {
+    std::string file;
+    std::unique_ptr<lane::LaneFileReader> reader;
+    // The positions of the frames to analyse, and the next one to take
+    std::vector<std::size_t> order;
+    std::size_t next = 0;
+    ChannelOutput output;
+    std::vector<lane::Histogram> spectra;
+    SampleStatistics clusters;
+    std::vector<SampleStatistics> classes;
+};
+
+// Writes the spectra of sampled frames scaled up to estimates for all the
+// frames, each channel by its own sampling fraction, with errors taken from
+// the Poisson errors on the sampled counts
+void writeSpectraEstimateCsv(
+    const std::string& fileName,
+    const std::vector<PreviewChannel>& channels
+) {
+    std::ofstream output(fileName, std::ios::trunc | std::ios::out);
+    if (!output.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+
+    // Each histogram's underflow, bins then overflow
+    auto getCount = [](const lane::Histogram& h, const std::size_t bin) {
+        if (bin == 0) {
+            return h.getUnderflow();
+        }
+        if (bin == h.getBinCount() + 1) {
+            return h.getOverflow();
+        }
+        return h.getCount(bin - 1);
+    };
+    output << "Histogram,Low,High,Sampled,Estimate,Error\n";
+    const auto spectra = createSpectra();
+    for (std::size_t s = 0; s < spectra.size(); ++s) {
+        const auto& spectrum = spectra[s];
+        const auto binCount = spectrum.getBinCount();
+        for (std::size_t bin = 0; bin < binCount + 2; ++bin) {
+            std::uint64_t sampled = 0;
+            double estimate = 0;
+            double variance = 0;
+            for (const auto& channel : channels) {
+                if (channel.clusters.count == 0) {
+                    continue;
+                }
+                const double scale = static_cast<double>(
+                    channel.reader->getFrameCount()
+                ) / channel.clusters.count;
+                const auto count = getCount(channel.spectra[s], bin);
+                sampled += count;
+                estimate += count * scale;
+                variance += count * scale * scale;
+            }
+            output << spectrum.getName() << ",";
+            if (bin == 0) {
+                output << "-inf";
+            } else {
+                output << spectrum.getBinEdge(bin - 1);
+            }
+            output << ",";
+            if (bin == binCount + 1) {
+                output << "inf";
+            } else {
+                output << spectrum.getBinEdge(bin);
+            }
+            output << "," << sampled << "," << estimate << ","
+                << std::sqrt(variance) << "\n";
+        }
+    }
+    if (!output) {
+        throw std::runtime_error("Unable to write file: " + fileName);
+    }
+}
+
+}
+
+void preview(
+    const std::string& inputPath,
+    const bool isRecursive,
+    const std::string& outputPath,
+    const SamplingSettings& sampling,
+    Analysis& analysis
+) {
+    using namespace std;
+    using namespace lane;
+    using namespace lane::utils;
+
+    auto start = chrono::steady_clock::now();
+    mt19937 random(sampling.seed);
+    auto inputs = walkDirectory(inputPath, "lane", isRecursive);
+    sort(inputs.begin(), inputs.end(), [](const FileInfo& lhs, const FileInfo& rhs) {
+        return lhs.path < rhs.path;
+    });
+    vector<PreviewChannel> channels;
+    for (const auto& input : inputs) {
+        auto index = LaneIndex::load(input.path);
+        for (const auto channelID : index.getChannelIDs()) {
+            channels.emplace_back();
+            auto& channel = channels.back();
+            channel.file = getRelativePath(inputPath, input.path);
+            channel.reader.reset(new LaneFileReader(input.path, index, channelID));
+            channel.order = getSampleOrder(
+                sampling, channel.reader->getFrameCount(), random
+            );
+            channel.output.channel = channelID;
+            channel.spectra = createSpectra();
+            channel.classes.resize(clusterClassCount);
+        }
+    }
+    // Only once the channels have stopped moving about
+    if (analysis.isWritingSpectra) {
+        for (auto& channel : channels) {
+            channel.output.spectra = &channel.spectra;
+        }
+    }
+
+    // Take a frame from each channel in turn, so a time budget is spread
+    // evenly over them
+    bool isTimed = sampling.mode == SamplingMode::Time;
+    auto deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(
+        chrono::duration<double>(sampling.value)
+    );
+    Frame frame;
+    bool isRemaining = true;
+    bool isOutOfTime = false;
+    while (isRemaining && !isOutOfTime) {
+        isRemaining = false;
+        for (auto& channel : channels) {
+            if (channel.next >= channel.order.size()) {
+                continue;
+            }
+            isRemaining = true;
+            // The sampled frame itself, even if it repeats an earlier one,
+            // so that the sample isn't skewed towards the frames after
+            // repeats
+            if (!channel.reader->readAt(channel.order[channel.next++], frame)) {
+                continue;
+            }
+            auto classCounts = channel.output.classCounts;
+            analysis.processFrame(frame, channel.output);
+            channel.clusters.add(analysis.batch.getSize());
+            if (analysis.isClassifying) {
+                for (size_t c = 0; c < clusterClassCount; ++c) {
+                    channel.classes[c].add(
+                        channel.output.classCounts[c] - classCounts[c]
+                    );
+                }
+            }
+            if (isTimed && chrono::steady_clock::now() >= deadline) {
+                isOutOfTime = true;
+                break;
+            }
+        }
+    }
+
+    ofstream rates(outputPath + "/preview.csv");
+    if (!rates.is_open()) {
+        throw runtime_error("Unable to open file: " + outputPath + "/preview.csv");
+    }
+    rates << "File,Channel,Quantity,Frames,SampledFrames,PerFrame,PerFrameError,"
+        "Total,TotalError\n";
+    auto writeRate = [&](
+        const PreviewChannel& channel,
+        const string& quantity,
+        const SampleStatistics& statistics
+    ) {
+        const auto frameCount = channel.reader->getFrameCount();
+        const auto error = statistics.getMeanError(frameCount);
+        rates << channel.file << "," << channel.output.channel
+            << "," << quantity << "," << frameCount << "," << statistics.count
+            << "," << statistics.getMean() << "," << error << ","
+            << statistics.getMean() * frameCount << "," << error * frameCount
+            << "\n";
+    };
+
+    size_t frameCount = 0;
+    size_t sampledCount = 0;
+    double total = 0;
+    double totalVariance = 0;
+    for (const auto& channel : channels) {
+        const auto& clusters = channel.clusters;
+        const auto frames = channel.reader->getFrameCount();
+        const auto error = clusters.getMeanError(frames);
+        cout << "Preview of '" << channel.file << "' channel "
+            << channel.output.channel << ": " << clusters.count << " of "
+            << frames << " frames, " << clusters.getMean() << " +- " << error
+            << " clusters per frame, about " << clusters.getMean() * frames
+            << " +- " << error * frames << " clusters\n";
+        writeRate(channel, "Clusters", clusters);
+        if (analysis.isClassifying) {
+            for (size_t c = 0; c < clusterClassCount; ++c) {
+                writeRate(
+                    channel,
+                    getClusterClassName(static_cast<ClusterClass>(c)),
+                    channel.classes[c]
+                );
+            }
+        }
+        frameCount += frames;
+        sampledCount += clusters.count;
+        total += clusters.getMean() * frames;
+        totalVariance += error * frames * error * frames;
+    }
+    if (analysis.isWritingSpectra) {
+        writeSpectraEstimateCsv(outputPath + "/preview_spectra.csv", channels);
+    }
+
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << "Sampled " << sampledCount << " of " << frameCount << " frames in "
+        << elapsed.count() << " s, about " << total << " +- "
+        << sqrt(totalVariance) << " clusters in all\n";
+}
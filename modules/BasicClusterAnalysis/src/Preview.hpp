@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Preview.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Quick look previews of input files from samples of their frames
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef PREVIEW_HPP
+#define PREVIEW_HPP
+
+#include <string>
+#include "FrameSampling.hpp"
+#include "Analysis.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Analyses a sample of the frames of the input files for a quick
+/// estimate of the cluster rates and spectra. The frames are jumped to using
+/// the files' indices rather than parsing past the rest. The estimates are
+/// reported, and written to preview.csv and preview_spectra.csv in the output
+/// directory.
+/// Throws a std::runtime_error if the inputs can't be read or the estimates
+/// can't be written.
+/// \param inputPath The directory holding the .lane files
+/// \param isRecursive Whether to look for .lane files in sub-directories too
+/// \param outputPath The directory to write the estimates to
+/// \param sampling How to choose the frames to analyse
+/// \param analysis The analysis to run on each sampled frame
+void preview(
+    const std::string& inputPath,
+    const bool isRecursive,
+    const std::string& outputPath,
+    const SamplingSettings& sampling,
+    Analysis& analysis
+);
+
+#endif // PREVIEW_HPP
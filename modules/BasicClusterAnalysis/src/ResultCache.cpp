@@ -0,0 +1,99 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ResultCache.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief A content addressed cache of the results of analysing input files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdint>
+#include "Utils/Filesystem.hpp"
+#include "Utils/Hash.hpp"
+#include "ResultCache.hpp"
+
+namespace {
+
+// Every complete entry has this file, holding its key
+const char entryFileName[] = "entry";
+
+}
+
+ResultCache::ResultCache(const std::string& directory)
+: directory_(directory) {
+    if (!lane::utils::makeDirectory(directory_)) {
+        throw std::runtime_error("Unable to create cache directory: " + directory_);
+    }
+}
+
+ResultCache::~ResultCache() noexcept = default;
+
+ResultCache::ResultCache(const ResultCache& other) = default;
+
+ResultCache::ResultCache(ResultCache&& other) = default;
+
+ResultCache& ResultCache::operator=(const ResultCache& other) = default;
+
+ResultCache& ResultCache::operator=(ResultCache&& other) = default;
+
+bool ResultCache::has(const std::uint64_t key) const noexcept {
+    try {
+        return lane::utils::fileExists(getFilePath(key, entryFileName));
+    } catch (...) {
+        return false;
+    }
+}
+
+std::string ResultCache::getFilePath(
+    const std::uint64_t key,
+    const std::string& name
+) const {
+    return directory_ + "/" + lane::utils::formatHash(key) + "/" + name;
+}
+
+std::string ResultCache::startEntry(const std::uint64_t key) const {
+    // Staging directories get a random suffix, so runs making the same
+    // entry don't collide
+    std::random_device random;
+    const auto staging = directory_ + "/" + lane::utils::formatHash(key) +
+        ".staging" + std::to_string(random());
+    if (!lane::utils::makeDirectory(staging)) {
+        throw std::runtime_error("Unable to create cache directory: " + staging);
+    }
+    return staging;
+}
+
+void ResultCache::finishEntry(
+    const std::uint64_t key,
+    const std::string& staging
+) const {
+    {
+        std::ofstream marker(staging + "/" + entryFileName);
+        marker << lane::utils::formatHash(key) << "\n";
+        if (!marker) {
+            throw std::runtime_error("Unable to write to cache directory: " + staging);
+        }
+    }
+
+    // Renaming fails if the entry's already there, in which case it's
+    // identical and the staged copy isn't needed
+    const auto entry = directory_ + "/" + lane::utils::formatHash(key);
+    if (std::rename(staging.c_str(), entry.c_str()) != 0) {
+        for (const auto& name : lane::utils::getDirectoryContents(staging)) {
+            std::remove((staging + "/" + name).c_str());
+        }
+        lane::utils::removeDirectory(staging);
+    }
+}
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ResultCache.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief A content addressed cache of the results of analysing input files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef RESULTCACHE_HPP
+#define RESULTCACHE_HPP
+
+#include <string>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Stores the output files from analysing an input file under a key
+/// worked out from everything the outputs depend on (the input's contents,
+/// the build of the module, the settings and the calibrations), so that
+/// analysing the same input the same way again only needs the stored files
+/// linking into place.
+/// Each entry is a directory named after its key, holding files with fixed
+/// names. Entries are written to a staging directory and renamed into place
+/// once complete, so several runs can share a cache without ever seeing a
+/// half written entry. Nothing is ever removed from the cache; delete the
+/// directory to clear it.
+class ResultCache final {
+public:
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Constructor. Throws a std::runtime_error if the cache directory
+    /// can't be created.
+    /// \param directory The directory to keep the cache in, which is created
+    /// if it doesn't exist
+    explicit ResultCache(const std::string& directory);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ~ResultCache() noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    /// \param other Object to be copy constructed from
+    ResultCache(const ResultCache& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move constructor
+    /// \param other Object to be move constructed from
+    ResultCache(ResultCache&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Copy assignment operator
+    /// \param other Object to be copy assigned from
+    ResultCache& operator=(const ResultCache& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Move assignment operator
+    /// \param other Object to be move assigned from
+    ResultCache& operator=(ResultCache&& other);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether there's a complete entry for a key
+    /// \param key The key of the entry
+    /// \return True if the entry exists
+    bool has(const std::uint64_t key) const noexcept;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the path of a file in an entry
+    /// \param key The key of the entry
+    /// \param name The name of the file in the entry
+    /// \return The path of the file
+    std::string getFilePath(
+        const std::uint64_t key,
+        const std::string& name
+    ) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Starts a new entry, by making a staging directory for its files
+    /// to be written or linked into. Staging directories are never seen as
+    /// entries, so one left behind by a failed run does no harm. Throws a
+    /// std::runtime_error if the directory can't be created.
+    /// \param key The key of the entry
+    /// \return The path of the staging directory
+    std::string startEntry(const std::uint64_t key) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Finishes a new entry once all its files are in the staging
+    /// directory, making it visible to has. If another run finished the same
+    /// entry first, that one is kept and the staged files are removed.
+    /// Throws a std::runtime_error if the entry can't be finished.
+    /// \param key The key of the entry
+    /// \param staging The staging directory returned by startEntry
+    void finishEntry(const std::uint64_t key, const std::string& staging) const;
+
+private:
+    std::string directory_;
+};
+
+#endif // RESULTCACHE_HPP
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ResultCacheKey.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Working out the result cache keys of input files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include "Utils/Filesystem.hpp"
+#include "Utils/Config.hpp"
+#include "Utils/System.hpp"
+#include "Utils/Hash.hpp"
+#include "Analysis.hpp"
+#include "OutputShards.hpp"
+#include "ResultCacheKey.hpp"
+
+namespace {
+
+// Changed whenever what's stored in the result cache changes, to keep old
+// entries from being used
+const char resultCacheVersion[] = "BCA result cache 3";
+
+// Identifies the build of the module by the hash of its executable, falling
+// back on the time it was compiled
+std::uint64_t getBuildID() {
+    const auto path = lane::utils::getExecutablePath();
+    if (!path.empty()) {
+        try {
+            return lane::utils::hashFile(path);
+        } catch (const std::runtime_error&) {
+        }
+    }
+    const std::string compiled = __DATE__ " " __TIME__;
+    return lane::utils::hash64(compiled.data(), compiled.size());
+}
+
+}
+
+std::uint64_t getResultCacheKey(
+    const Analysis& analysis,
+    const lane::utils::Config& config,
+    const std::string& calibrationsPath
+) {
+    std::ostringstream settings;
+    settings.precision(17);
+    settings << resultCacheVersion << "\n"
+        << "build " << lane::utils::formatHash(getBuildID()) << "\n"
+        << "hotPixels " << analysis.isFindingHotPixels << "\n"
+        << "background " << analysis.isSubtractingBackground;
+    if (analysis.isSubtractingBackground) {
+        settings << " " << config.getDouble("background", "weight", 0.05)
+            << " " << config.getDouble("background", "minLevel", 1.0);
+    }
+    settings << "\n"
+        << "fields " << analysis.fields.to_string() << "\n"
+        << "table " << analysis.isWritingTable << "\n"
+        << "spectra " << analysis.isWritingSpectra << "\n";
+    const auto shardLayout = parseShardLayout(
+        config.getString("output", "shards", "none")
+    );
+    settings << "shards " << static_cast<int>(shardLayout);
+    if (shardLayout == ShardLayout::Frames) {
+        settings << " " << config.getInteger("output", "shardFrames", 10000);
+    }
+    settings << "\n";
+    if (analysis.isClassifying) {
+        const auto& cuts = analysis.cuts;
+        settings << "classifier " << cuts.dotMaxSize << " "
+            << cuts.smallBlobMaxSize << " " << cuts.blobMaxEccentricity << " "
+            << cuts.heavyMinHeight << " " << cuts.straightMinEccentricity << "\n";
+    }
+
+    // Calibration files are taken in path order, so the key doesn't depend
+    // on the order they're listed in
+    auto calibrations = lane::utils::walkDirectory(calibrationsPath);
+    std::sort(
+        calibrations.begin(),
+        calibrations.end(),
+        [](const lane::utils::FileInfo& a, const lane::utils::FileInfo& b) {
+            return a.path < b.path;
+        }
+    );
+    for (const auto& calibration : calibrations) {
+        settings << "calibration " << calibration.path.substr(calibrationsPath.size())
+            << " " << lane::utils::formatHash(lane::utils::hashFile(calibration.path))
+            << "\n";
+    }
+
+    lane::utils::Hash64 key;
+    key.update(settings.str());
+    return key.getDigest();
+}
+
+std::uint64_t getInputCacheKey(
+    const std::uint64_t resultCacheKey,
+    const std::string& input
+) {
+    lane::utils::Hash64 key(resultCacheKey);
+    const auto inputHash = lane::utils::hashFile(input);
+    key.update(&inputHash, sizeof(inputHash));
+    return key.getDigest();
+}
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file ResultCacheKey.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Working out the result cache keys of input files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef RESULTCACHEKEY_HPP
+#define RESULTCACHEKEY_HPP
+
+#include <string>
+#include <cstdint>
+#include "Utils/Config.hpp"
+#include "Analysis.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Works out the part of the result cache key shared by every input
+/// file, from the build of the module, the settings which change the outputs
+/// of each file, and the contents of the calibrations directory. Settings
+/// which only change how the outputs are made (threads, memory) are left out,
+/// as are the hot pixel thresholds, which are only applied to the statistics
+/// of all the files once they're merged together.
+/// Throws a std::runtime_error if a calibration file can't be read.
+/// \param analysis The analysis settings
+/// \param config The module settings
+/// \param calibrationsPath The calibrations directory
+/// \return The shared part of the key
+std::uint64_t getResultCacheKey(
+    const Analysis& analysis,
+    const lane::utils::Config& config,
+    const std::string& calibrationsPath
+);
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Works out the result cache key of an input file, from the shared
+/// part of the key and the file's contents.
+/// Throws a std::runtime_error if the file can't be read.
+/// \param resultCacheKey The key made by getResultCacheKey
+/// \param input The path of the input file
+/// \return The key of the input file's outputs
+std::uint64_t getInputCacheKey(
+    const std::uint64_t resultCacheKey,
+    const std::string& input
+);
+
+#endif // RESULTCACHEKEY_HPP
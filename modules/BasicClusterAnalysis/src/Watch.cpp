@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Watch.cpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Analysing LUCID raw data files as they arrive
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include "Utils/Filesystem.hpp"
+#include "Utils/FileWatcher.hpp"
+#include "Frame.hpp"
+#include "LucidHeader.hpp"
+#include "LucidFile.hpp"
+#include "DuplicateFrameFilter.hpp"
+#include "PixelMask.hpp"
+#include "ClusterTable.hpp"
+#include "Histogram.hpp"
+#include "Analysis.hpp"
+#include "OutputNames.hpp"
+#include "Watch.hpp"
+
+void watch(
+    std::string inputPath,
+    const std::string& outputPath,
+    const std::string& masksPath,
+    Analysis& analysis
+) {
+    using namespace std;
+    using namespace lane;
+    using namespace lane::utils;
+
+    while (inputPath.size() > 1 && (inputPath.back() == '/' || inputPath.back() == '\\')) {
+        inputPath.pop_back();
+    }
+    FileWatcher watcher(inputPath, "ldat");
+    cout << "Watching '" << inputPath << "' for new .ldat files" << endl;
+
+    // Frames are numbered on from those of the capture's earlier files
+    map<string, map<uint32_t, unsigned int>> frameNumbers;
+    // The files of a capture split frames between them, so the frame cut
+    // short at the end of each file is kept until the rest of it arrives
+    map<string, vector<unsigned char>> carriedOver;
+    string lastCapture;
+    // Frames repeated in the capture's earlier files are dropped
+    DuplicateFrameFilter duplicates;
+    Frame masked;
+    for (;;) {
+        for (const auto& input : watcher.wait(1000)) {
+            try {
+                auto start = chrono::steady_clock::now();
+                auto captureName = getCaptureName(getPath(input));
+                auto outputStem = getWatchOutputName(inputPath, input);
+                auto outputName = outputPath + "/" + outputStem;
+                // The files of a capture follow on from one another, so the
+                // background carries over between them
+                if (outputStem != lastCapture) {
+                    analysis.background.clear();
+                    duplicates.clear();
+                    lastCapture = outputStem;
+                }
+                vector<unsigned char> data(getFileSize(input));
+                data.resize(readFileRange(input, 0, data.data(), data.size()));
+                // What's carried over is dropped if this file can't be read,
+                // rather than stopping every later file being read too
+                auto& carried = carriedOver[outputStem];
+                vector<unsigned char> pending;
+                pending.swap(carried);
+
+                // A file with a header starts a new run of the capture, so
+                // the frame cut short at the end of the last one is final
+                map<uint32_t, vector<Frame>> frames;
+                uint64_t duplicateCount = 0;
+                if (
+                    !pending.empty() &&
+                    data.size() >= lucidHeaderSize &&
+                    parseLucidHeader(data.data()).isValid
+                ) {
+                    LucidFile last;
+                    last.decode(pending, duplicates, true);
+                    frames = last.getChannelToFramesMap();
+                    duplicateCount += last.getDuplicateFrameCount();
+                    pending.clear();
+                }
+                pending.insert(pending.end(), data.begin(), data.end());
+                LucidFile file;
+                const auto end = file.decode(pending, duplicates, false);
+                for (const auto& channel : file.getChannelToFramesMap()) {
+                    auto& channelFrames = frames[channel.first];
+                    channelFrames.insert(
+                        channelFrames.end(),
+                        channel.second.begin(),
+                        channel.second.end()
+                    );
+                }
+                duplicateCount += file.getDuplicateFrameCount();
+                carried.assign(pending.begin() + end, pending.end());
+
+                ofstream outf(
+                    outputName + ".bca",
+                    fstream::out | fstream::binary | fstream::app
+                );
+                if (!outf.is_open()) {
+                    throw runtime_error("Unable to write to file: " + outputName + ".bca");
+                }
+                // Cluster tables can't be added to, so each file gets its own
+                unique_ptr<ClusterTableWriter> table;
+                if (analysis.isWritingTable) {
+                    table.reset(new ClusterTableWriter(
+                        outputName + "_" + removeExtension(getFileName(input)) + ".lct",
+                        getTableColumns(analysis.fields)
+                    ));
+                }
+                auto spectra = createSpectra();
+                ofstream classCountsFile;
+                if (analysis.isClassifying) {
+                    auto classCountsName = outputPath + "/classes.csv";
+                    bool isNew = !fileExists(classCountsName);
+                    classCountsFile.open(classCountsName, fstream::out | fstream::app);
+                    if (isNew) {
+                        writeClassCountsHeader(classCountsFile);
+                    }
+                }
+
+                size_t frameCount = 0;
+                for (const auto& channel : frames) {
+                    outf << "Channel " << channel.first << "\n";
+                    ChannelOutput output;
+                    output.bca = &outf;
+                    output.table = table.get();
+                    output.spectra = analysis.isWritingSpectra ? &spectra : nullptr;
+                    output.channel = channel.first;
+                    auto& frameNumber = frameNumbers[outputStem][channel.first];
+                    output.frameNumber = frameNumber + 1;
+
+                    auto maskName = getMaskFileName(
+                        masksPath, captureName, channel.first
+                    );
+                    bool isMasking = fileExists(maskName);
+                    PixelMask mask;
+                    if (isMasking) {
+                        mask.read(maskName);
+                    }
+                    for (const auto& f : channel.second) {
+                        if (isMasking) {
+                            mask.apply(f, masked);
+                            analysis.processFrame(masked, output);
+                        } else {
+                            analysis.processFrame(f, output);
+                        }
+                    }
+                    frameNumber = output.frameNumber - 1;
+                    frameCount += channel.second.size();
+                    if (analysis.isClassifying) {
+                        writeClassCounts(
+                            classCountsFile,
+                            getFileName(input),
+                            channel.first,
+                            output.classCounts
+                        );
+                    }
+                }
+                if (table) {
+                    table->close();
+                }
+                if (analysis.isWritingSpectra) {
+                    auto spectraName = outputName + ".hist";
+                    if (fileExists(spectraName)) {
+                        auto total = readHistograms(spectraName);
+                        mergeHistograms(total, spectra);
+                        spectra = std::move(total);
+                    }
+                    writeHistograms(spectraName, spectra);
+                }
+
+                chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+                cout << "Analysed '" << input << "' (" << frameCount
+                    << " frames";
+                if (duplicateCount != 0) {
+                    cout << ", " << duplicateCount
+                        << " repeated frames dropped";
+                }
+                cout << ") in " << elapsed.count() << " s" << endl;
+            } catch (const std::exception& e) {
+                cout << "Unable to analyse '" << input << "'\n" << e.what() << endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file Watch.hpp
+/// \author Hector Stalker <hstalker0@gmail.com> &
+/// Sam Kittle
+/// \version 0.1
+///
+/// \brief Analysing LUCID raw data files as they arrive
+///
+/// \copyright Copyright (c) 2014, Hector Stalker & Sam Kittle.
+/// All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#ifndef WATCH_HPP
+#define WATCH_HPP
+
+#include <string>
+#include "Analysis.hpp"
+
+///////////////////////////////////////////////////////////////////////////////
+/// \brief Analyses LUCID raw data files as they're finished in the input
+/// directory tree, until the process is stopped. The clusters of each file
+/// are appended to the outputs of its capture (see getWatchOutputName), and
+/// the hot pixel masks of the capture (see getCaptureName) written by earlier
+/// batch runs are applied first. A frame split between a file and the next
+/// one of its capture is analysed along with the next one, once it's whole
+/// \param inputPath The directory to watch
+/// \param outputPath The directory to write the outputs to
+/// \param masksPath The directory holding the hot pixel masks
+/// \param analysis The analysis to run on each frame
+void watch(
+    std::string inputPath,
+    const std::string& outputPath,
+    const std::string& masksPath,
+    Analysis& analysis
+);
+
+#endif // WATCH_HPP
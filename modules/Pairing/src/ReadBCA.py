@@ -1,5 +1,5 @@
 #!/usr/bin/env python2
-import os, sys, glob
+import os, sys, glob, csv
 
 class Frame:
     clusters = []
@@ -18,11 +18,32 @@ def splitLine(l):
             key += c
     return key, value.strip()
 
+def readManifest(path):
+    # Gets the paths of the shards listed in a .bcm manifest, in order
+    directory = os.path.dirname(path)
+    f = open(path)
+    shards = [os.path.join(directory, row['File']) for row in csv.DictReader(f)]
+    f.close()
+    return shards
+
 def getPaths(path):
+    # The clusters of an input file are either in a single .bca file, or
+    # split into shards listed by a .bcm manifest, which stands in for them
     paths = glob.glob(os.path.join(path, 'BCA_*.txt'))
-    return paths    
+    paths += glob.glob(os.path.join(path, '*.bca'))
+    manifests = glob.glob(os.path.join(path, '*.bcm'))
+    sharded = set()
+    for m in manifests:
+        sharded.update(os.path.normpath(p) for p in readManifest(m))
+    paths = [p for p in paths if os.path.normpath(p) not in sharded]
+    return paths + manifests
     
 def readFile(path):
+    if path.endswith('.bcm'):
+        frames = []
+        for shard in readManifest(path):
+            frames += readFile(shard)
+        return frames
     frameMeta = ('TimeStamp', 'ShutterTime')
     f = open(path)
     lines = f.readlines()
@@ -55,5 +76,8 @@ def readFile(path):
             cluster = {}
         else:
             cluster[key] = value
+    # The last cluster isn't followed by another Frame line
+    if cluster:
+        currentFrame.clusters.append(cluster)
     return frames
     
\ No newline at end of file
@@ -266,15 +266,12 @@ class LUCIDFile:
                     elif (ord(current) >> 7) == 0x00:
                         # Number of zeroes (0-)
                         current = input.read(2)
-                        numberOfZeroes = ord(struct.unpack('>H', current[0:2])[0])
-                        for i in range(0, numberOfZeroes):
-                            currentFrame.setPixel(pixel)
-                            output.write(str(x) + ',' + str(y) + ',' + str(payload) + '\n')
-                            if x == 255:
-                                x = 0
-                                y += 1
-                            else:
-                                x += 1
+                        numberOfZeroes = int(struct.unpack('>H', current[0:2])[0])
+                        numberOfZeroes = numberOfZeroes & 32767
+                        # Skip the run in one go, wrapping onto later rows
+                        position = y * 256 + x + numberOfZeroes
+                        x = position % 256
+                        y = position // 256
 
                 output.write('EOF\n')
             output.write('EOC\n')
@@ -1,6 +1,12 @@
 #!/usr/bin/env python2
 """Sorts the lucid files for a certain date into separate captures"""
-import os, sys, glob, shutil, errno
+import os, sys, glob, shutil, errno, subprocess
+
+# The laneCapture tool joins files in the kernel, without the data passing
+# through python, when it's installed alongside the scripts
+laneCapture = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)), '..', 'tools', 'laneCapture'
+)
 
 def joinFiles(files, output):
     """Joins the given files into the given output file
@@ -12,8 +18,12 @@ def joinFiles(files, output):
     if len(files) < 2:
         return
 
-    # Read in and append all file data to a new file in order givena
     mkdirP(os.path.dirname(output))
+    if os.path.isfile(laneCapture):
+        subprocess.check_call([laneCapture, 'concat', output] + files)
+        return
+
+    # Read in and append all file data to a new file in order given
     out = open(output, 'wb')
     for f in files:
         input = open(f, 'rb')
@@ -135,6 +145,13 @@ if __name__ == '__main__':
     else:
         destinationPath = os.path.abspath(sys.argv[1])
 
+    # laneCapture does the same much faster, reading only the file headers
+    if os.path.isfile(laneCapture):
+        mkdirP(destinationPath)
+        sys.exit(subprocess.call(
+            [laneCapture, 'sort', sys.argv[1], destinationPath]
+        ))
+
     # Grab files in the directory and sort them
     files = sortByTimeStamps(listFiles(sys.argv[1], 'ldat'))
 
@@ -0,0 +1,429 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneCapture/src/Main.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Command line tool for joining and splitting capture files
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstdint>
+#include "Utils/Filesystem.hpp"
+#include "LaneIndex.hpp"
+#include "LucidHeader.hpp"
+#include "LucidFile.hpp"
+#include "DuplicateFrameFilter.hpp"
+
+namespace {
+
+void printUsage(const char* name) {
+    std::cout << "USAGE: " << name << " concat output-file input-file...\n"
+        << "       " << name << " split [-c] [-t SECONDS] input-file output-dir\n"
+        << "       " << name << " sort [-n] [-d] input-dir output-dir\n"
+        << "concat joins .ldat or .lane files in the order given. The headers\n"
+        << "of all but the first .lane file are left out.\n"
+        << "split splits a .lane file on frame boundaries into one file\n"
+        << "  -c  per channel (NAME_channelN.lane)\n"
+        << "  -t  per window of SECONDS from the first frame (NAME_partN.lane)\n"
+        << "Frame indices (.lidx) are written for every .lane file created.\n"
+        << "sort groups the .ldat files in a directory into captures, using\n"
+        << "only their headers, and joins the files of each capture into\n"
+        << "NAME_joined.ldat, named after its first file.\n"
+        << "  -n  only list the captures\n"
+        << "  -d  drop repeated frames while joining, such as those\n"
+        << "      retransmitted or in overlapping files\n";
+}
+
+// Gets the first line of a file, which holds a .lane file's ID,STARTTIME
+// header, including its line end
+std::string readHeader(const std::string& fileName) {
+    std::ifstream input(fileName, std::ios::binary | std::ios::in);
+    if (!input.is_open()) {
+        throw std::runtime_error("Unable to open file: " + fileName);
+    }
+    std::string header;
+    if (!std::getline(input, header) || input.eof()) {
+        throw std::runtime_error("Missing header in file: " + fileName);
+    }
+    return header + "\n";
+}
+
+// Appends some text to a file, optionally replacing what was there
+void writeText(
+    const std::string& fileName,
+    const std::string& text,
+    const bool isReplacing = false
+) {
+    std::ofstream output(
+        fileName,
+        std::ios::binary | std::ios::out |
+            (isReplacing ? std::ios::trunc : std::ios::app)
+    );
+    if (!output.is_open() || !output.write(text.data(), text.size())) {
+        throw std::runtime_error("Unable to write to file: " + fileName);
+    }
+}
+
+void concatenate(
+    const std::string& output,
+    const std::vector<std::string>& inputs
+) {
+    using namespace lane;
+    for (const auto& input : inputs) {
+        if (input == output) {
+            throw std::runtime_error("Output file is also an input: " + output);
+        }
+    }
+
+    const bool isLane = utils::hasExtension(output, "lane");
+    writeText(output, "", true);
+    std::vector<LaneIndexEntry> entries;
+    std::uint64_t outputSize = 0;
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        const auto& input = inputs[i];
+        const auto size = utils::getFileSize(input);
+        std::uint64_t skipped = 0;
+        if (isLane) {
+            // Only the first file's header is kept, and the frames of the
+            // rest move along by where their bodies end up
+            if (i != 0) {
+                skipped = readHeader(input).size();
+            }
+            const auto shift = outputSize - skipped;
+            const auto index = LaneIndex::load(input);
+            for (auto entry : index.getEntries()) {
+                entry.offset += shift;
+                entries.emplace_back(entry);
+            }
+        }
+        std::cout << "Appending '" << input << "'\n";
+        utils::appendFileRange(output, input, skipped, size - skipped);
+        outputSize += size - skipped;
+    }
+    if (isLane) {
+        LaneIndex(std::move(entries), output).write(
+            LaneIndex::getIndexFileName(output)
+        );
+    }
+}
+
+// Finds the end of a frame, just after its EOF line
+std::uint64_t getFrameEnd(std::ifstream& input, const std::uint64_t offset) {
+    input.clear();
+    input.seekg(offset);
+    std::uint64_t position = offset;
+    std::string buffer;
+    while (std::getline(input, buffer)) {
+        position += buffer.size() + 1;
+        if (buffer == "EOF") {
+            return position;
+        }
+    }
+    throw std::runtime_error("Unterminated frame in input file");
+}
+
+// A .lane file being written by split
+struct SplitOutput {
+    std::uint64_t size;
+    std::vector<lane::LaneIndexEntry> entries;
+};
+
+void split(
+    const std::string& input,
+    const std::string& outputDirectory,
+    const bool isByChannel,
+    const std::uint32_t window
+) {
+    using namespace lane;
+    const auto header = readHeader(input);
+    const auto index = LaneIndex::load(input);
+    const auto& entries = index.getEntries();
+    std::ifstream file(input, std::ios::binary | std::ios::in);
+    if (!file.is_open()) {
+        throw std::runtime_error("Unable to open file: " + input);
+    }
+
+    std::uint32_t firstTimeStamp = 0;
+    if (!entries.empty()) {
+        firstTimeStamp = std::min_element(
+            entries.begin(),
+            entries.end(),
+            [](const LaneIndexEntry& lhs, const LaneIndexEntry& rhs) {
+                return lhs.timeStamp < rhs.timeStamp;
+            }
+        )->timeStamp;
+    }
+    const auto baseName = outputDirectory + "/" +
+        utils::removeExtension(utils::getFileName(input));
+    auto getOutputName = [&](const LaneIndexEntry& entry) {
+        auto name = baseName;
+        if (window != 0) {
+            name += "_part" + std::to_string(
+                (entry.timeStamp - firstTimeStamp) / window
+            );
+        }
+        if (isByChannel) {
+            name += "_channel" + std::to_string(entry.channelID);
+        }
+        return name + ".lane";
+    };
+
+    // Frames going to the same file from the same channel are copied across
+    // together, as a single range, in their own channel section
+    std::map<std::string, SplitOutput> outputs;
+    std::size_t i = 0;
+    while (i < entries.size()) {
+        const auto name = getOutputName(entries[i]);
+        const auto channelID = entries[i].channelID;
+        std::size_t end = i + 1;
+        while (end < entries.size() &&
+            entries[end].channelID == channelID &&
+            getOutputName(entries[end]) == name) {
+            ++end;
+        }
+        const auto start = entries[i].offset;
+        const auto length = getFrameEnd(file, entries[end - 1].offset) - start;
+
+        auto found = outputs.find(name);
+        if (found == outputs.end()) {
+            found = outputs.emplace(name, SplitOutput{ 0, {} }).first;
+            writeText(name, header, true);
+            found->second.size = header.size();
+        }
+        auto& output = found->second;
+        const auto channelLine = std::to_string(channelID) + "\n";
+        writeText(name, channelLine);
+        output.size += channelLine.size();
+        for (auto j = i; j < end; ++j) {
+            auto entry = entries[j];
+            entry.offset = output.size + (entry.offset - start);
+            output.entries.emplace_back(entry);
+        }
+        utils::appendFileRange(name, input, start, length);
+        writeText(name, "EOC\n");
+        output.size += length + 4;
+        i = end;
+    }
+
+    for (auto& output : outputs) {
+        std::cout << "Wrote '" << output.first << "' ("
+            << output.second.entries.size() << " frames)\n";
+        LaneIndex(std::move(output.second.entries), output.first).write(
+            LaneIndex::getIndexFileName(output.first)
+        );
+    }
+}
+
+std::string getCompressionName(const lane::LucidCompression compression) {
+    switch (compression) {
+    case lane::LucidCompression::RLE:
+        return "RLE";
+    case lane::LucidCompression::XYV:
+        return "XYV";
+    default:
+        return "None";
+    }
+}
+
+// Joins the files of a capture, leaving out the frames which repeat earlier
+// ones. The files are decoded one at a time, carrying any frame cut short at
+// the end of a file on to the next, and only the fingerprints of recent
+// frames are kept, so memory use doesn't grow with the capture.
+// Returns the number of frames left out
+std::uint64_t joinWithoutRepeats(
+    const std::string& output,
+    const std::vector<lane::utils::FileInfo>& files
+) {
+    using namespace lane;
+    std::ofstream out(output, std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Unable to write to file: " + output);
+    }
+    auto write = [&](const std::vector<unsigned char>& data,
+        const std::size_t begin, const std::size_t size) {
+        if (!out.write(reinterpret_cast<const char*>(&data[begin]), size)) {
+            throw std::runtime_error("Unable to write to file: " + output);
+        }
+    };
+
+    DuplicateFrameFilter duplicates;
+    LucidFile lucid;
+    std::uint64_t dropped = 0;
+    std::vector<unsigned char> data;
+    std::string path;
+    auto decode = [&](const bool isFinal) {
+        std::size_t end = 0;
+        try {
+            end = lucid.decode(data, duplicates, isFinal);
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error(std::string(e.what()) + " (" + path + ")");
+        }
+        // Anything before the first frame is a header, or the end of a frame
+        // from before the capture
+        const auto& records = lucid.getFrameRecords();
+        write(data, 0, records.empty() ? end : records.front().offset);
+        for (const auto& record : records) {
+            if (record.isDuplicate) {
+                ++dropped;
+            } else {
+                write(data, record.offset, record.size);
+            }
+        }
+        data.erase(data.begin(), data.begin() + end);
+    };
+
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        path = files[i].path;
+        std::ifstream input(path, std::ios::binary | std::ios::in);
+        if (!input.is_open()) {
+            throw std::runtime_error("Unable to open file: " + path);
+        }
+        std::vector<unsigned char> bytes(files[i].size);
+        input.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+        bytes.resize(static_cast<std::size_t>(input.gcount()));
+
+        // A file with a header doesn't carry on the frame before it
+        if (!data.empty() && bytes.size() >= lucidHeaderSize &&
+            parseLucidHeader(bytes.data()).isValid) {
+            decode(true);
+        }
+        data.insert(data.end(), bytes.begin(), bytes.end());
+        decode(i + 1 == files.size());
+    }
+    // Whatever's left is too short to be a frame, and is kept as it is
+    if (!data.empty()) {
+        write(data, 0, data.size());
+    }
+    return dropped;
+}
+
+void sortCaptures(
+    const std::string& inputDirectory,
+    const std::string& outputDirectory,
+    const bool isListingOnly,
+    const bool isDroppingRepeats
+) {
+    using namespace lane;
+    auto captures = groupLucidCaptures(
+        scanLucidHeaders(utils::walkDirectory(inputDirectory, "ldat"))
+    );
+    for (const auto& capture : captures) {
+        const auto& header = capture.header;
+        std::uint64_t size = 0;
+        for (const auto& file : capture.files) {
+            size += file.size;
+        }
+        auto name = outputDirectory + "/" +
+            utils::removeExtension(utils::getFileName(capture.files[0].path)) +
+            "_joined.ldat";
+        std::cout << name << "\n";
+        if (header.isValid) {
+            std::cout << "  ID " << header.fileID
+                << ", start time " << header.startTime
+                << ", active chips 0x" << std::hex
+                << static_cast<unsigned int>(header.activeChips) << std::dec
+                << ", compression " << getCompressionName(header.compression)
+                << "\n";
+        } else {
+            std::cout << "  No header found\n";
+        }
+        std::cout << "  " << capture.files.size() << " files, "
+            << size << " bytes\n";
+        if (isListingOnly) {
+            continue;
+        }
+        writeText(name, "", true);
+        // XYV compressed data can't be decoded, so is joined as it is
+        if (isDroppingRepeats && header.compression != LucidCompression::XYV) {
+            std::cout << "  " << joinWithoutRepeats(name, capture.files)
+                << " repeated frames dropped\n";
+            continue;
+        }
+        for (const auto& file : capture.files) {
+            utils::appendFileRange(name, file.path, 0, file.size);
+        }
+    }
+    std::cout << captures.size() << " captures\n";
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    using namespace std;
+
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    try {
+        string command = argv[1];
+        if (command == "concat" && argc >= 4) {
+            vector<string> inputs(argv + 3, argv + argc);
+            concatenate(argv[2], inputs);
+            return 0;
+        }
+        if (command == "sort") {
+            bool isListingOnly = false;
+            bool isDroppingRepeats = false;
+            vector<string> paths;
+            for (int i = 2; i < argc; ++i) {
+                string arg = argv[i];
+                if (arg == "-n") {
+                    isListingOnly = true;
+                } else if (arg == "-d") {
+                    isDroppingRepeats = true;
+                } else {
+                    paths.emplace_back(arg);
+                }
+            }
+            if (paths.size() == 2) {
+                sortCaptures(paths[0], paths[1], isListingOnly, isDroppingRepeats);
+                return 0;
+            }
+        }
+        if (command == "split") {
+            bool isByChannel = false;
+            unsigned long window = 0;
+            vector<string> paths;
+            for (int i = 2; i < argc; ++i) {
+                string arg = argv[i];
+                if (arg == "-c") {
+                    isByChannel = true;
+                } else if (arg == "-t" && i + 1 < argc) {
+                    char* end = nullptr;
+                    window = strtoul(argv[++i], &end, 10);
+                    if (*end != '\0' || window == 0) {
+                        throw runtime_error("Invalid time window: " + string(argv[i]));
+                    }
+                } else {
+                    paths.emplace_back(arg);
+                }
+            }
+            if (paths.size() == 2 && (isByChannel || window != 0)) {
+                if (!lane::utils::hasExtension(paths[0], "lane")) {
+                    throw runtime_error("Only .lane files can be split: " + paths[0]);
+                }
+                split(paths[0], paths[1], isByChannel, window);
+                return 0;
+            }
+        }
+        printUsage(argv[0]);
+        return 1;
+    } catch (const std::exception& e) {
+        cerr << "An error occurred.\n" << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,141 @@
+///////////////////////////////////////////////////////////////////////////////
+/// \file LaneQuery/src/Main.cpp
+/// \author Hector Stalker <hstalker0@gmail.com>
+/// \version 0.1
+///
+/// \brief Command line tool for querying the cluster tables written by the
+/// analysis modules
+///
+/// \copyright Copyright (c) 2014, Hector Stalker. All rights reserved.
+/// This file is under the Simplified (2-clause) BSD license
+/// For conditions of distribution and use, see:
+/// http://opensource.org/licenses/BSD-2-Clause
+/// or read the 'LICENSE.md' file distributed with this code
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdio>
+#include <cstdlib>
+#include "Utils/Filesystem.hpp"
+#include "ClusterTable.hpp"
+
+namespace {
+
+void printUsage(const char* name) {
+    std::cout << "USAGE: " << name
+        << " [-s COLUMN,...] [-w COLUMN:MIN:MAX]... table-file-or-dir...\n"
+        << "  -s  Columns to output, all of them by default\n"
+        << "  -w  Only output rows with MIN <= COLUMN <= MAX. Either bound may\n"
+        << "      be left empty. May be given more than once.\n"
+        << "Directories are searched recursively for .lct files. Matching\n"
+        << "rows are written to standard output as CSV.\n";
+}
+
+std::vector<std::string> split(const std::string& text, const char separator) {
+    std::vector<std::string> parts;
+    std::string::size_type start = 0;
+    while (true) {
+        auto end = text.find(separator, start);
+        parts.emplace_back(text.substr(start, end - start));
+        if (end == std::string::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    return parts;
+}
+
+double parseBound(const std::string& text, const double fallback) {
+    if (text.empty()) {
+        return fallback;
+    }
+    char* end = nullptr;
+    double value = std::strtod(text.c_str(), &end);
+    if (*end != '\0') {
+        throw std::runtime_error("Invalid number in condition: " + text);
+    }
+    return value;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    using namespace std;
+    using namespace lane;
+    using namespace lane::utils;
+
+    ClusterQuery query;
+    vector<string> tables;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            string arg = argv[i];
+            if ((arg == "-s" || arg == "-w") && i + 1 < argc) {
+                string value = argv[++i];
+                if (arg == "-s") {
+                    query.select(split(value, ','));
+                } else {
+                    auto parts = split(value, ':');
+                    if (parts.size() != 3 || parts[0].empty()) {
+                        throw runtime_error("Invalid condition: " + value);
+                    }
+                    query.where(
+                        parts[0],
+                        parseBound(parts[1], -numeric_limits<double>::infinity()),
+                        parseBound(parts[2], numeric_limits<double>::infinity())
+                    );
+                }
+            } else if (!arg.empty() && arg[0] == '-') {
+                printUsage(argv[0]);
+                return 1;
+            } else if (getExtension(arg) == "lct") {
+                tables.emplace_back(arg);
+            } else {
+                // Search sub-directories too, in a set order
+                auto files = walkDirectory(arg, "lct");
+                sort(
+                    files.begin(),
+                    files.end(),
+                    [](const FileInfo& lhs, const FileInfo& rhs) {
+                        return lhs.path < rhs.path;
+                    }
+                );
+                for (const auto& file : files) {
+                    tables.emplace_back(file.path);
+                }
+            }
+        }
+        if (tables.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        QueryResult result;
+        for (const auto& table : tables) {
+            query.run(table, result);
+        }
+
+        for (size_t c = 0; c < result.columns.size(); ++c) {
+            cout << (c == 0 ? "" : ",") << result.columns[c];
+        }
+        cout << "\n";
+        char number[32];
+        for (size_t r = 0; r < result.getRowCount(); ++r) {
+            for (size_t c = 0; c < result.values.size(); ++c) {
+                snprintf(number, sizeof(number), "%.10g", result.values[c][r]);
+                cout << (c == 0 ? "" : ",") << number;
+            }
+            cout << "\n";
+        }
+        cerr << result.getRowCount() << " rows matched in " << tables.size()
+            << " tables (" << result.blocksScanned << " blocks scanned, "
+            << result.blocksSkipped << " skipped)\n";
+    } catch (const std::exception& e) {
+        cerr << "An error occurred.\n" << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}